@@ -95,6 +95,94 @@ BENCHMARK(BM_Encrypt)
     ->Unit(benchmark::kMicrosecond)
     ->ADD_SAMPLE_VECTOR_SIZE_ARGS;
 
+// Streaming encryption in chunks of IPCL_STREAM_CHUNK_SIZE into a vector,
+// with fresh randomness since setRandom covers one encrypt call only
+static void BM_Encrypt_Stream(benchmark::State& state) {
+  size_t dsize = state.range(0);
+
+  BigNumber n = P_BN * Q_BN;
+  int n_length = n.BitSize();
+  ipcl::PublicKey pk(n, n_length, Enable_DJN);
+
+  std::vector<BigNumber> exp_bn_v(dsize);
+  for (size_t i = 0; i < dsize; i++)
+    exp_bn_v[i] = P_BN - BigNumber((unsigned int)(i * 1024));
+
+  ipcl::PlainText pt(exp_bn_v);
+  std::vector<BigNumber> ct;
+  for (auto _ : state)
+    pk.encryptStream(ipcl::textSource(pt), ipcl::vectorSink(ct));
+}
+BENCHMARK(BM_Encrypt_Stream)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({16})
+    ->Args({1024});
+
+// Key owner encryption, obfuscators computed modulo p^2 and q^2
+static void BM_Encrypt_KeyOwner(benchmark::State& state) {
+  size_t dsize = state.range(0);
+
+  BigNumber n = P_BN * Q_BN;
+  int n_length = n.BitSize();
+  ipcl::PublicKey pk(n, n_length, Enable_DJN);
+  ipcl::PrivateKey sk(pk, P_BN, Q_BN);
+
+  std::vector<BigNumber> r_bn_v(dsize, R_BN);
+  pk.setRandom(r_bn_v);
+  pk.setHS(HS_BN);
+
+  std::vector<BigNumber> exp_bn_v(dsize);
+  for (size_t i = 0; i < dsize; i++)
+    exp_bn_v[i] = P_BN - BigNumber((unsigned int)(i * 1024));
+
+  ipcl::PlainText pt(exp_bn_v);
+
+  ipcl::CipherText ct;
+  for (auto _ : state) ct = sk.encrypt(pk, pt);
+}
+BENCHMARK(BM_Encrypt_KeyOwner)
+    ->Unit(benchmark::kMicrosecond)
+    ->ADD_SAMPLE_VECTOR_SIZE_ARGS;
+
+// Encryption of 32-bit values packed into slots with the default headroom
+static void BM_Encrypt_Packed(benchmark::State& state) {
+  size_t dsize = state.range(0);
+
+  BigNumber n = P_BN * Q_BN;
+  int n_length = n.BitSize();
+  ipcl::PublicKey pk(n, n_length, Enable_DJN);
+  ipcl::SlotPacker packer(pk, 32);
+
+  std::vector<uint32_t> exp_v(dsize);
+  for (size_t i = 0; i < dsize; i++) exp_v[i] = (unsigned int)(i * 1024);
+
+  ipcl::CipherText ct;
+  for (auto _ : state) ct = pk.encrypt(packer.pack(exp_v));
+}
+BENCHMARK(BM_Encrypt_Packed)
+    ->Unit(benchmark::kMicrosecond)
+    ->ADD_SAMPLE_VECTOR_SIZE_ARGS;
+
+static void BM_Encrypt_Raw(benchmark::State& state) {
+  size_t dsize = state.range(0);
+
+  BigNumber n = P_BN * Q_BN;
+  int n_length = n.BitSize();
+  ipcl::PublicKey pk(n, n_length, Enable_DJN);
+
+  std::vector<BigNumber> exp_bn_v(dsize);
+  for (size_t i = 0; i < dsize; i++)
+    exp_bn_v[i] = P_BN - BigNumber((unsigned int)(i * 1024));
+
+  ipcl::PlainText pt(exp_bn_v);
+
+  ipcl::CipherText ct;
+  for (auto _ : state) ct = pk.encrypt(pt, false);
+}
+BENCHMARK(BM_Encrypt_Raw)
+    ->Unit(benchmark::kMicrosecond)
+    ->ADD_SAMPLE_VECTOR_SIZE_ARGS;
+
 static void BM_Decrypt(benchmark::State& state) {
   size_t dsize = state.range(0);
 
@@ -119,3 +207,90 @@ static void BM_Decrypt(benchmark::State& state) {
 BENCHMARK(BM_Decrypt)
     ->Unit(benchmark::kMicrosecond)
     ->ADD_SAMPLE_VECTOR_SIZE_ARGS;
+
+// Small plaintexts decrypted into native integers (state.range(1) == 1) or
+// into a PlainText converted element by element
+static void BM_Decrypt_To(benchmark::State& state) {
+  size_t dsize = state.range(0);
+  bool native = state.range(1);
+
+  BigNumber n = P_BN * Q_BN;
+  int n_length = n.BitSize();
+  ipcl::PublicKey pk(n, n_length, Enable_DJN);
+  ipcl::PrivateKey sk(pk, P_BN, Q_BN);
+
+  std::vector<BigNumber> r_bn_v(dsize, R_BN);
+  pk.setRandom(r_bn_v);
+  pk.setHS(HS_BN);
+
+  std::vector<uint32_t> exp_v(dsize);
+  for (size_t i = 0; i < dsize; i++) exp_v[i] = i * 1024;
+
+  ipcl::CipherText ct = pk.encrypt(ipcl::PlainText(exp_v));
+  std::vector<uint64_t> out(dsize);
+  for (auto _ : state) {
+    if (native) {
+      sk.decrypt_to(ct, out.data(), dsize);
+    } else {
+      ipcl::PlainText dt = sk.decrypt(ct);
+      for (size_t i = 0; i < dsize; i++) out[i] = dt.getElementVec(i)[0];
+    }
+  }
+}
+
+BENCHMARK(BM_Decrypt_To)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{16, 256}, {0, 1}});
+
+// Streaming decryption in chunks of IPCL_STREAM_CHUNK_SIZE into a vector
+static void BM_Decrypt_Stream(benchmark::State& state) {
+  size_t dsize = state.range(0);
+
+  BigNumber n = P_BN * Q_BN;
+  int n_length = n.BitSize();
+  ipcl::PublicKey pk(n, n_length, Enable_DJN);
+  ipcl::PrivateKey sk(pk, P_BN, Q_BN);
+
+  std::vector<BigNumber> r_bn_v(dsize, R_BN);
+  pk.setRandom(r_bn_v);
+  pk.setHS(HS_BN);
+
+  std::vector<BigNumber> exp_bn_v(dsize);
+  for (size_t i = 0; i < dsize; i++)
+    exp_bn_v[i] = P_BN - BigNumber((unsigned int)(i * 1024));
+
+  ipcl::CipherText ct = pk.encrypt(ipcl::PlainText(exp_bn_v));
+  std::vector<BigNumber> dt;
+  for (auto _ : state)
+    sk.decryptStream(ipcl::textSource(ct), ipcl::vectorSink(dt));
+}
+
+BENCHMARK(BM_Decrypt_Stream)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({16})
+    ->Args({1024});
+
+// Compaction of 32-bit results into slots followed by one decryption per
+// packed element
+static void BM_Decrypt_Compact(benchmark::State& state) {
+  size_t dsize = state.range(0);
+
+  BigNumber n = P_BN * Q_BN;
+  int n_length = n.BitSize();
+  ipcl::PublicKey pk(n, n_length, Enable_DJN);
+  ipcl::PrivateKey sk(pk, P_BN, Q_BN);
+  ipcl::SlotPacker packer(pk, 32, 0);
+
+  std::vector<uint32_t> exp_v(dsize);
+  for (size_t i = 0; i < dsize; i++) exp_v[i] = (unsigned int)(i * 1024);
+
+  ipcl::CipherText ct = pk.encrypt(ipcl::PlainText(exp_v));
+  BigNumber bound(0xffffffffu);
+  std::vector<BigNumber> dt;
+  for (auto _ : state)
+    dt = ipcl::PackedCipherText::compact(packer, ct, bound).decrypt(sk);
+}
+
+BENCHMARK(BM_Decrypt_Compact)
+    ->Unit(benchmark::kMicrosecond)
+    ->ADD_SAMPLE_VECTOR_SIZE_ARGS;
@@ -93,6 +93,37 @@ BENCHMARK(BM_Add_CTCT)
     ->Unit(benchmark::kMicrosecond)
     ->ADD_SAMPLE_VECTOR_SIZE_ARGS;
 
+static void BM_Sub_CTCT(benchmark::State& state) {
+  size_t dsize = state.range(0);
+
+  BigNumber n = P_BN * Q_BN;
+  int n_length = n.BitSize();
+  ipcl::PublicKey pk(n, n_length, Enable_DJN);
+  ipcl::PrivateKey sk(pk, P_BN, Q_BN);
+
+  std::vector<BigNumber> r_bn_v(dsize, R_BN);
+  pk.setRandom(r_bn_v);
+  pk.setHS(HS_BN);
+
+  std::vector<BigNumber> exp_bn1_v(dsize), exp_bn2_v(dsize);
+  for (int i = 0; i < dsize; i++) {
+    exp_bn1_v[i] = P_BN - BigNumber((unsigned int)(i * 1024));
+    exp_bn2_v[i] = Q_BN + BigNumber((unsigned int)(i * 1024));
+  }
+
+  ipcl::PlainText pt1(exp_bn1_v);
+  ipcl::PlainText pt2(exp_bn2_v);
+
+  ipcl::CipherText ct1 = pk.encrypt(pt1);
+  ipcl::CipherText ct2 = pk.encrypt(pt2);
+
+  ipcl::CipherText diff;
+  for (auto _ : state) diff = ct1 - ct2;
+}
+BENCHMARK(BM_Sub_CTCT)
+    ->Unit(benchmark::kMicrosecond)
+    ->ADD_SAMPLE_VECTOR_SIZE_ARGS;
+
 static void BM_Add_CTPT(benchmark::State& state) {
   size_t dsize = state.range(0);
 
@@ -151,3 +182,335 @@ static void BM_Mul_CTPT(benchmark::State& state) {
 BENCHMARK(BM_Mul_CTPT)
     ->Unit(benchmark::kMicrosecond)
     ->ADD_SAMPLE_VECTOR_SIZE_ARGS;
+
+static void BM_Mul_Signed_CTPT(benchmark::State& state) {
+  size_t dsize = state.range(0);
+  BigNumber n = P_BN * Q_BN;
+  int n_length = n.BitSize();
+  ipcl::PublicKey pk(n, n_length, Enable_DJN);
+  ipcl::PrivateKey sk(pk, P_BN, Q_BN);
+
+  std::vector<BigNumber> r_bn_v(dsize, R_BN);
+  pk.setRandom(r_bn_v);
+  pk.setHS(HS_BN);
+
+  // 32-bit weights, every other one negative and encoded as n - |w|
+  std::vector<BigNumber> exp_bn1_v(dsize), exp_bn2_v(dsize);
+  for (int i = 0; i < dsize; i++) {
+    exp_bn1_v[i] = P_BN - BigNumber((unsigned int)(i * 1024));
+    BigNumber w((unsigned int)(0x80000000u + i * 1024));
+    exp_bn2_v[i] = i % 2 ? n - w : w;
+  }
+
+  ipcl::PlainText pt1(exp_bn1_v);
+  ipcl::PlainText pt2(exp_bn2_v);
+
+  ipcl::CipherText ct1 = pk.encrypt(pt1);
+
+  ipcl::CipherText product;
+  for (auto _ : state) product = ct1 * pt2;
+}
+BENCHMARK(BM_Mul_Signed_CTPT)
+    ->Unit(benchmark::kMicrosecond)
+    ->ADD_SAMPLE_VECTOR_SIZE_ARGS;
+
+static void BM_Mul_FanOut_CTPT(benchmark::State& state) {
+  size_t dsize = state.range(0);
+  BigNumber n = P_BN * Q_BN;
+  int n_length = n.BitSize();
+  ipcl::PublicKey pk(n, n_length, Enable_DJN);
+  ipcl::PrivateKey sk(pk, P_BN, Q_BN);
+
+  std::vector<BigNumber> r_bn_v(1, R_BN);
+  pk.setRandom(r_bn_v);
+  pk.setHS(HS_BN);
+
+  std::vector<BigNumber> exp_bn_v(dsize);
+  for (int i = 0; i < dsize; i++)
+    exp_bn_v[i] = Q_BN + BigNumber((unsigned int)(i * 1024));
+
+  ipcl::PlainText pt1(P_BN);
+  ipcl::PlainText pt2(exp_bn_v);
+
+  ipcl::CipherText ct1 = pk.encrypt(pt1);
+  ct1.precompute();
+
+  ipcl::CipherText product;
+  for (auto _ : state) product = ct1 * pt2;
+}
+BENCHMARK(BM_Mul_FanOut_CTPT)
+    ->Unit(benchmark::kMicrosecond)
+    ->ADD_SAMPLE_VECTOR_SIZE_ARGS;
+
+static void BM_Sum_CT(benchmark::State& state) {
+  size_t dsize = state.range(0);
+
+  BigNumber n = P_BN * Q_BN;
+  int n_length = n.BitSize();
+  ipcl::PublicKey pk(n, n_length, Enable_DJN);
+  ipcl::PrivateKey sk(pk, P_BN, Q_BN);
+
+  std::vector<BigNumber> r_bn_v(dsize, R_BN);
+  pk.setRandom(r_bn_v);
+  pk.setHS(HS_BN);
+
+  std::vector<BigNumber> exp_bn_v(dsize);
+  for (int i = 0; i < dsize; i++)
+    exp_bn_v[i] = P_BN - BigNumber((unsigned int)(i * 1024));
+
+  ipcl::PlainText pt(exp_bn_v);
+
+  ipcl::CipherText ct = pk.encrypt(pt);
+
+  ipcl::CipherText sum;
+  for (auto _ : state) sum = ct.sum();
+}
+BENCHMARK(BM_Sum_CT)
+    ->Unit(benchmark::kMicrosecond)
+    ->ADD_SAMPLE_VECTOR_SIZE_ARGS;
+
+static void BM_Dot_CTPT(benchmark::State& state) {
+  size_t dsize = state.range(0);
+
+  BigNumber n = P_BN * Q_BN;
+  int n_length = n.BitSize();
+  ipcl::PublicKey pk(n, n_length, Enable_DJN);
+  ipcl::PrivateKey sk(pk, P_BN, Q_BN);
+
+  std::vector<BigNumber> r_bn_v(dsize, R_BN);
+  pk.setRandom(r_bn_v);
+  pk.setHS(HS_BN);
+
+  std::vector<BigNumber> exp_bn1_v(dsize), exp_bn2_v(dsize);
+  for (int i = 0; i < dsize; i++) {
+    exp_bn1_v[i] = P_BN - BigNumber((unsigned int)(i * 1024));
+    exp_bn2_v[i] = Q_BN + BigNumber((unsigned int)(i * 1024));
+  }
+
+  ipcl::PlainText pt1(exp_bn1_v);
+  ipcl::PlainText pt2(exp_bn2_v);
+
+  ipcl::CipherText ct1 = pk.encrypt(pt1);
+
+  ipcl::CipherText product;
+  for (auto _ : state) product = ct1.dot(pt2);
+}
+BENCHMARK(BM_Dot_CTPT)
+    ->Unit(benchmark::kMicrosecond)
+    ->ADD_SAMPLE_VECTOR_SIZE_ARGS;
+
+#define ADD_SAMPLE_MATRIX_SIZE_ARGS \
+  Args({16, 64})->Args({64, 64})->Args({256, 64})->Args({64, 256})
+
+static ipcl::DenseMatrix sampleMatrix(size_t rows, size_t cols) {
+  ipcl::DenseMatrix mat;
+  mat.rows = rows;
+  mat.cols = cols;
+  for (size_t i = 0; i < rows * cols; i++)
+    mat.values.push_back(Q_BN + BigNumber((unsigned int)(i * 1024)));
+  return mat;
+}
+
+static void BM_MatVec_CTPT(benchmark::State& state) {
+  size_t rows = state.range(0);
+  size_t dsize = state.range(1);
+
+  BigNumber n = P_BN * Q_BN;
+  int n_length = n.BitSize();
+  ipcl::PublicKey pk(n, n_length, Enable_DJN);
+  ipcl::PrivateKey sk(pk, P_BN, Q_BN);
+
+  std::vector<BigNumber> r_bn_v(dsize, R_BN);
+  pk.setRandom(r_bn_v);
+  pk.setHS(HS_BN);
+
+  std::vector<BigNumber> exp_bn_v(dsize);
+  for (int i = 0; i < dsize; i++)
+    exp_bn_v[i] = P_BN - BigNumber((unsigned int)(i * 1024));
+
+  ipcl::PlainText pt(exp_bn_v);
+  ipcl::CipherText ct = pk.encrypt(pt);
+  ipcl::DenseMatrix mat = sampleMatrix(rows, dsize);
+
+  ipcl::CipherText product;
+  for (auto _ : state) product = ct.matVec(mat);
+}
+BENCHMARK(BM_MatVec_CTPT)
+    ->Unit(benchmark::kMicrosecond)
+    ->ADD_SAMPLE_MATRIX_SIZE_ARGS;
+
+// Row by row CT * PT followed by sum, the baseline of BM_MatVec_CTPT
+static void BM_MatVec_Naive_CTPT(benchmark::State& state) {
+  size_t rows = state.range(0);
+  size_t dsize = state.range(1);
+
+  BigNumber n = P_BN * Q_BN;
+  int n_length = n.BitSize();
+  ipcl::PublicKey pk(n, n_length, Enable_DJN);
+  ipcl::PrivateKey sk(pk, P_BN, Q_BN);
+
+  std::vector<BigNumber> r_bn_v(dsize, R_BN);
+  pk.setRandom(r_bn_v);
+  pk.setHS(HS_BN);
+
+  std::vector<BigNumber> exp_bn_v(dsize);
+  for (int i = 0; i < dsize; i++)
+    exp_bn_v[i] = P_BN - BigNumber((unsigned int)(i * 1024));
+
+  ipcl::PlainText pt(exp_bn_v);
+  ipcl::CipherText ct = pk.encrypt(pt);
+  ipcl::DenseMatrix mat = sampleMatrix(rows, dsize);
+
+  std::vector<BigNumber> res(rows);
+  for (auto _ : state) {
+    for (size_t r = 0; r < rows; r++) {
+      std::vector<BigNumber> row(mat.values.begin() + r * dsize,
+                                 mat.values.begin() + (r + 1) * dsize);
+      ipcl::CipherText product = ct * ipcl::PlainText(row);
+      res[r] = product.sum().getElement(0);
+    }
+  }
+}
+BENCHMARK(BM_MatVec_Naive_CTPT)
+    ->Unit(benchmark::kMicrosecond)
+    ->ADD_SAMPLE_MATRIX_SIZE_ARGS;
+
+// a * x + b * y + c + p, evaluated eagerly (state.range(1) == 0) or as one
+// lazy expression
+static void BM_Expr_CTPT(benchmark::State& state) {
+  size_t dsize = state.range(0);
+  bool lazy = state.range(1);
+
+  BigNumber n = P_BN * Q_BN;
+  int n_length = n.BitSize();
+  ipcl::PublicKey pk(n, n_length, Enable_DJN);
+  ipcl::PrivateKey sk(pk, P_BN, Q_BN);
+
+  std::vector<BigNumber> r_bn_v(dsize, R_BN);
+  pk.setRandom(r_bn_v);
+  pk.setHS(HS_BN);
+
+  std::vector<BigNumber> exp_bn1_v(dsize), exp_bn2_v(dsize);
+  for (int i = 0; i < dsize; i++) {
+    exp_bn1_v[i] = P_BN - BigNumber((unsigned int)(i * 1024));
+    exp_bn2_v[i] = Q_BN + BigNumber((unsigned int)(i * 1024));
+  }
+
+  ipcl::PlainText pt1(exp_bn1_v);
+  ipcl::PlainText pt2(exp_bn2_v);
+
+  ipcl::CipherText a = pk.encrypt(pt1);
+  ipcl::CipherText b = pk.encrypt(pt2);
+  ipcl::CipherText c = pk.encrypt(pt1);
+
+  ipcl::CipherText res;
+  if (lazy) {
+    for (auto _ : state)
+      res = (a.lazy() * pt2 + b.lazy() * pt1 + c + pt2).eval();
+  } else {
+    for (auto _ : state) res = a * pt2 + b * pt1 + c + pt2;
+  }
+}
+BENCHMARK(BM_Expr_CTPT)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{16, 64, 256}, {0, 1}});
+
+// 16 chained CT + CT, in normal form (state.range(1) == 0) or kept in
+// Montgomery form
+static void BM_AddChain_CTCT(benchmark::State& state) {
+  size_t dsize = state.range(0);
+  bool mont = state.range(1);
+
+  BigNumber n = P_BN * Q_BN;
+  int n_length = n.BitSize();
+  ipcl::PublicKey pk(n, n_length, Enable_DJN);
+  ipcl::PrivateKey sk(pk, P_BN, Q_BN);
+
+  std::vector<BigNumber> r_bn_v(dsize, R_BN);
+  pk.setRandom(r_bn_v);
+  pk.setHS(HS_BN);
+
+  std::vector<BigNumber> exp_bn_v(dsize);
+  for (int i = 0; i < dsize; i++)
+    exp_bn_v[i] = P_BN - BigNumber((unsigned int)(i * 1024));
+
+  ipcl::PlainText pt(exp_bn_v);
+
+  ipcl::CipherText ct = pk.encrypt(pt);
+  if (mont) ct = ct.toMontgomery();
+
+  ipcl::CipherText sum;
+  for (auto _ : state) {
+    sum = ct;
+    for (int k = 0; k < 16; k++) sum = sum + ct;
+  }
+}
+BENCHMARK(BM_AddChain_CTCT)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{16, 64, 256}, {0, 1}});
+
+// 64 CipherTexts summed with chained CT + CT (state.range(1) == 0) or a
+// CipherAccumulator
+static void BM_Accumulate_CT(benchmark::State& state) {
+  size_t dsize = state.range(0);
+  bool accumulate = state.range(1);
+
+  BigNumber n = P_BN * Q_BN;
+  int n_length = n.BitSize();
+  ipcl::PublicKey pk(n, n_length, Enable_DJN);
+  ipcl::PrivateKey sk(pk, P_BN, Q_BN);
+
+  std::vector<BigNumber> r_bn_v(dsize, R_BN);
+  pk.setRandom(r_bn_v);
+  pk.setHS(HS_BN);
+
+  std::vector<BigNumber> exp_bn_v(dsize);
+  for (int i = 0; i < dsize; i++)
+    exp_bn_v[i] = P_BN - BigNumber((unsigned int)(i * 1024));
+
+  ipcl::PlainText pt(exp_bn_v);
+
+  ipcl::CipherText ct = pk.encrypt(pt);
+
+  ipcl::CipherText sum;
+  for (auto _ : state) {
+    if (accumulate) {
+      ipcl::CipherAccumulator acc(pk, dsize);
+      for (int k = 0; k < 64; k++) acc += ct;
+      sum = acc.getCipherText();
+    } else {
+      sum = ct;
+      for (int k = 1; k < 64; k++) sum = sum + ct;
+    }
+  }
+}
+BENCHMARK(BM_Accumulate_CT)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{16, 64, 256}, {0, 1}});
+
+// Reduction of double width values modulo n with BigNumber::operator%
+// (state.range(1) == 0), a Barrett (1) or a Montgomery (2) ModReducer
+static void BM_Reduce_N(benchmark::State& state) {
+  size_t dsize = state.range(0);
+  int method = state.range(1);
+
+  BigNumber n = P_BN * Q_BN;
+  std::vector<BigNumber> x(dsize);
+  for (int i = 0; i < dsize; i++)
+    x[i] = (n - BigNumber((unsigned int)(i + 1))) * R_BN;
+
+  ipcl::ModReducer red(n, method == 1 ? ipcl::ModReducer::Method::Barrett
+                                      : ipcl::ModReducer::Method::Montgomery);
+
+  std::vector<BigNumber> r(dsize);
+  for (auto _ : state) {
+    if (method == 0) {
+      for (int i = 0; i < dsize; i++) r[i] = x[i] % n;
+    } else {
+      red.reduce(r, x);
+    }
+  }
+}
+BENCHMARK(BM_Reduce_N)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{16, 256}, {0, 1, 2}});
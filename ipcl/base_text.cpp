@@ -22,8 +22,8 @@ BaseText::BaseText(const std::vector<BigNumber>& bn_v)
     : m_texts(bn_v), m_size(m_texts.size()) {}
 
 BaseText::BaseText(const BaseText& bt) {
-  this->m_texts = bt.getTexts();
-  this->m_size = bt.getSize();
+  this->m_texts = bt.m_texts;
+  this->m_size = bt.m_size;
 }
 
 BaseText& BaseText::operator=(const BaseText& other) {
@@ -109,6 +109,26 @@ void BigNumber::Set(const Ipp32u* pData, int length,
   ippsSet_BN(sgn, length, pData, BN(*this));
 }
 
+void BigNumber::Reserve(int length) {
+  if (Capacity() >= length) return;
+
+  IppsBigNumSGN bnSgn;
+  int bnBitLen;
+  Ipp32u* bnData;
+  ippsRef_BN(&bnSgn, &bnBitLen, &bnData, m_pBN);
+
+  IppsBigNumState* old = m_pBN;
+  create(nullptr, length);
+  ippsSet_BN(bnSgn, BITSIZE_WORD(bnBitLen), bnData, m_pBN);
+  delete[](Ipp8u*) old;
+}
+
+int BigNumber::Capacity() const {
+  int length;
+  ippsGetSize_BN(m_pBN, &length);
+  return length;
+}
+
 //
 // constants
 //
@@ -315,6 +335,48 @@ BigNumber operator%(const BigNumber& a, Ipp32u n) {
   return r;
 }
 
+//
+// output parameter arithmetic
+//
+static int WordSize(const BigNumber& bn) {
+  int bnBitLen;
+  ippsRef_BN(nullptr, &bnBitLen, nullptr, BN(bn));
+  return BITSIZE_WORD(bnBitLen);
+}
+
+void add_into(BigNumber& out, const BigNumber& a, const BigNumber& b) {
+  out.Reserve(IPP_MAX(WordSize(a), WordSize(b)) + 1);
+  ippsAdd_BN(BN(a), BN(b), BN(out));
+}
+
+void sub_into(BigNumber& out, const BigNumber& a, const BigNumber& b) {
+  out.Reserve(IPP_MAX(WordSize(a), WordSize(b)));
+  ippsSub_BN(BN(a), BN(b), BN(out));
+}
+
+void mul_into(BigNumber& out, const BigNumber& a, const BigNumber& b) {
+  out.Reserve(WordSize(a) + WordSize(b));
+  ippsMul_BN(BN(a), BN(b), BN(out));
+}
+
+void mod_into(BigNumber& out, const BigNumber& a, const BigNumber& m) {
+  out.Reserve(WordSize(m));
+  ippsMod_BN(BN(a), BN(m), BN(out));
+}
+
+void div_into(BigNumber& q, BigNumber& r, const BigNumber& a,
+              const BigNumber& b) {
+  q.Reserve(WordSize(a));
+  r.Reserve(WordSize(b));
+  ippsDiv_BN(BN(a), BN(b), BN(q), BN(r));
+}
+
+void mulmod_into(BigNumber& out, const BigNumber& a, const BigNumber& b,
+                 const BigNumber& m, BigNumber& scratch) {
+  mul_into(scratch, a, b);
+  mod_into(out, scratch, m);
+}
+
 //
 // modulo arithmetic
 //
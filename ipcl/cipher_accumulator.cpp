@@ -0,0 +1,49 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ipcl/cipher_accumulator.hpp"
+
+#include "ipcl/utils/util.hpp"
+
+namespace ipcl {
+
+CipherAccumulator::CipherAccumulator(const PublicKey& pk, std::size_t size)
+    : m_pk(std::make_shared<PublicKey>(pk)), m_size(size) {
+  ERROR_CHECK(size > 0, "CipherAccumulator: size must be positive");
+
+  m_acc = m_pk->getNSQMulEngine()->accInit(size);
+}
+
+void CipherAccumulator::add(const CipherText& ct) {
+  std::size_t ct_size = ct.getSize();
+  ERROR_CHECK(ct_size == m_size || ct_size == 1,
+              "CipherAccumulator: Size mismatch!");
+  ERROR_CHECK(*(m_pk->getN()) == *(ct.getPubKey()->getN()),
+              "CipherAccumulator: different public keys detected!");
+
+  // The raw elements, Montgomery ones carry the R that the product removes
+  std::vector<BigNumber> x = ct.BaseText::getTexts();
+  if (ct_size != m_size) x.assign(m_size, x.front());
+
+  m_pk->getNSQMulEngine()->accMul(m_acc, x);
+  if (!ct.isMontgomery()) m_shift++;
+  m_count++;
+}
+
+void CipherAccumulator::merge(const CipherAccumulator& other) {
+  ERROR_CHECK(other.m_size == m_size, "CipherAccumulator: Size mismatch!");
+  ERROR_CHECK(*(m_pk->getN()) == *(other.m_pk->getN()),
+              "CipherAccumulator: different public keys detected!");
+
+  m_pk->getNSQMulEngine()->accMerge(m_acc, other.m_acc);
+  m_shift += other.m_shift + 1;
+  m_count += other.m_count;
+}
+
+CipherText CipherAccumulator::getCipherText() const {
+  std::vector<BigNumber> sum;
+  m_pk->getNSQMulEngine()->accFinalize(sum, m_acc, m_size, m_shift);
+  return CipherText(*m_pk, sum);
+}
+
+}  // namespace ipcl
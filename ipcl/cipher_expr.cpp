@@ -0,0 +1,318 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ipcl/cipher_expr.hpp"
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ipcl/mod_inv.hpp"
+#include "ipcl/multi_exp.hpp"
+#include "ipcl/utils/util.hpp"
+
+namespace ipcl {
+
+struct CipherExpr::Node {
+  enum class Kind { Leaf, AddCt, AddPt, MulPt };
+
+  Kind kind;
+  std::size_t size;
+  std::shared_ptr<PublicKey> pk;
+  std::shared_ptr<const CipherText> leaf;  ///< Leaf only
+  std::shared_ptr<const Node> lhs;         ///< All but Leaf
+  std::shared_ptr<const Node> rhs;         ///< AddCt only
+  std::vector<BigNumber> pt;               ///< AddPt and MulPt only
+};
+
+namespace {
+
+using Node = CipherExpr::Node;
+
+/**
+ * Expression folded into prod(leaf^coef) * (1 + offset * n), coefficient and
+ * offset vectors have size 1 when they are broadcast
+ */
+struct LinearForm {
+  std::map<const Node*, std::vector<BigNumber>> terms;
+  std::vector<BigNumber> offset;  ///< Empty without plaintext offset
+};
+
+std::size_t broadcastSize(std::size_t a, std::size_t b, const char* op) {
+  ERROR_CHECK(a == b || a == 1 || b == 1,
+              std::string("CipherExpr: Size mismatch in ") + op);
+  return std::max(a, b);
+}
+
+template <typename Op>
+std::vector<BigNumber> zipWith(const std::vector<BigNumber>& a,
+                               const std::vector<BigNumber>& b, Op op) {
+  std::size_t size = std::max(a.size(), b.size());
+  std::vector<BigNumber> r(size);
+  for (std::size_t i = 0; i < size; i++)
+    r[i] = op(a[a.size() == 1 ? 0 : i], b[b.size() == 1 ? 0 : i]);
+  return r;
+}
+
+std::vector<BigNumber> expand(const std::vector<BigNumber>& v,
+                              std::size_t size) {
+  return v.size() == size ? v : std::vector<BigNumber>(size, v.front());
+}
+
+bool isOne(const std::vector<BigNumber>& v) {
+  return std::all_of(v.begin(), v.end(),
+                     [](const BigNumber& x) { return x == BigNumber::One(); });
+}
+
+/**
+ * Distinct leaves met while folding, keyed by leafKey. Leaves holding the
+ * same elements share the first one as their term.
+ */
+using LeafSet = std::unordered_multimap<std::size_t, const Node*>;
+
+// Size, form and a hash of the stored first element, a cheap filter before
+// comparing leaves element by element
+std::size_t leafKey(const CipherText& ct) {
+  BigNumber first = ct.BaseText::getElement(0);
+  int bits;
+  Ipp32u* data;
+  ippsRef_BN(nullptr, &bits, &data, BN(first));
+
+  std::size_t h = ct.getSize() * 2 + (ct.isMontgomery() ? 1 : 0);
+  for (int i = 0; i < BITSIZE_WORD(bits); i++)
+    h = (h ^ data[i]) * 0x100000001b3ULL;
+  return h;
+}
+
+// Compares the stored elements, leaves of different forms never match
+bool sameElements(const CipherText& a, const CipherText& b) {
+  if (a.getSize() != b.getSize() || a.isMontgomery() != b.isMontgomery())
+    return false;
+  for (std::size_t i = 0; i < a.getSize(); i++)
+    if (a.BaseText::getElement(i) != b.BaseText::getElement(i)) return false;
+  return true;
+}
+
+const Node* canonicalLeaf(const Node* node, LeafSet& leaves) {
+  std::size_t key = leafKey(*(node->leaf));
+  auto range = leaves.equal_range(key);
+  for (auto it = range.first; it != range.second; ++it)
+    if (sameElements(*(it->second->leaf), *(node->leaf))) return it->second;
+  leaves.emplace(key, node);
+  return node;
+}
+
+// Fold the graph bottom up, shared sub-expressions are folded once
+const LinearForm& fold(const Node* node, const ModReducer& red_n,
+                       std::unordered_map<const Node*, LinearForm>& memo,
+                       LeafSet& leaves) {
+  auto it = memo.find(node);
+  if (it != memo.end()) return it->second;
+
+  LinearForm form;
+  auto add = [](const BigNumber& a, const BigNumber& b) { return a + b; };
+  auto mul = [](const BigNumber& a, const BigNumber& b) { return a * b; };
+  auto mod_n = [&](std::vector<BigNumber>& v) { red_n.reduce(v, v); };
+
+  switch (node->kind) {
+    case Node::Kind::Leaf:
+      // Separate lazy() calls on one CipherText give separate leaves, they
+      // still make a single term
+      form.terms[canonicalLeaf(node, leaves)] = {BigNumber::One()};
+      break;
+    case Node::Kind::AddCt: {
+      form = fold(node->lhs.get(), red_n, memo, leaves);
+      const LinearForm& r = fold(node->rhs.get(), red_n, memo, leaves);
+      for (const auto& term : r.terms) {
+        auto t = form.terms.find(term.first);
+        if (t == form.terms.end())
+          form.terms.insert(term);
+        else
+          t->second = zipWith(t->second, term.second, add);
+      }
+      if (!r.offset.empty()) {
+        form.offset = form.offset.empty()
+                          ? r.offset
+                          : zipWith(form.offset, r.offset, add);
+        mod_n(form.offset);
+      }
+      break;
+    }
+    case Node::Kind::AddPt:
+      form = fold(node->lhs.get(), red_n, memo, leaves);
+      form.offset = form.offset.empty() ? node->pt
+                                        : zipWith(form.offset, node->pt, add);
+      mod_n(form.offset);
+      break;
+    case Node::Kind::MulPt:
+      // (prod(c^w) * g^m)^k = prod(c^(w * k)) * g^(m * k), the signed
+      // weights are kept exact since the order of c is unknown
+      form = fold(node->lhs.get(), red_n, memo, leaves);
+      for (auto& term : form.terms)
+        term.second = zipWith(term.second, node->pt, mul);
+      if (!form.offset.empty()) {
+        form.offset = zipWith(form.offset, node->pt, mul);
+        mod_n(form.offset);
+      }
+      break;
+  }
+
+  return memo.emplace(node, std::move(form)).first->second;
+}
+
+}  // namespace
+
+CipherExpr::CipherExpr(const CipherText& ct) {
+  ERROR_CHECK(ct.getSize() > 0, "CipherExpr: Empty CipherText");
+
+  auto node = std::make_shared<Node>();
+  node->kind = Node::Kind::Leaf;
+  node->size = ct.getSize();
+  node->pk = ct.getPubKey();
+  node->leaf = std::make_shared<const CipherText>(ct);
+  m_node = node;
+}
+
+CipherExpr::CipherExpr(std::shared_ptr<const Node> node) : m_node(node) {}
+
+CipherExpr CipherExpr::operator+(const CipherExpr& other) const {
+  ERROR_CHECK(*(m_node->pk->getN()) == *(other.m_node->pk->getN()),
+              "CT + CT error: 2 different public keys detected!");
+
+  auto node = std::make_shared<Node>();
+  node->kind = Node::Kind::AddCt;
+  node->size = broadcastSize(m_node->size, other.m_node->size, "CT + CT");
+  node->pk = m_node->pk;
+  node->lhs = m_node;
+  node->rhs = other.m_node;
+  return CipherExpr(node);
+}
+
+CipherExpr CipherExpr::operator+(const CipherText& other) const {
+  return this->operator+(CipherExpr(other));
+}
+
+CipherExpr CipherExpr::operator+(const PlainText& other) const {
+  auto node = std::make_shared<Node>();
+  node->kind = Node::Kind::AddPt;
+  node->size = broadcastSize(m_node->size, other.getSize(), "CT + PT");
+  node->pk = m_node->pk;
+  node->lhs = m_node;
+  node->pt = other.getTexts();
+  return CipherExpr(node);
+}
+
+CipherExpr CipherExpr::operator*(const PlainText& other) const {
+  // Plaintexts in (n / 2, n) encode -(n - m) as in CT * PT, both forms of
+  // negative plaintexts become short negative weights
+  const BigNumber& n = *(m_node->pk->getN());
+  const BigNumber half = n / 2;
+  std::vector<BigNumber> w = other.getTexts();
+  for (BigNumber& x : w)
+    if (x > half && x < n) x = x - n;
+
+  auto node = std::make_shared<Node>();
+  node->kind = Node::Kind::MulPt;
+  node->size = broadcastSize(m_node->size, other.getSize(), "CT * PT");
+  node->pk = m_node->pk;
+  node->lhs = m_node;
+  node->pt = std::move(w);
+  return CipherExpr(node);
+}
+
+std::size_t CipherExpr::getSize() const { return m_node->size; }
+
+CipherText CipherExpr::eval() const {
+  const PublicKey& pk = *(m_node->pk);
+  const std::size_t v_size = m_node->size;
+
+  std::unordered_map<const Node*, LinearForm> memo;
+  LeafSet leaves;
+  const LinearForm& form =
+      fold(m_node.get(), *(pk.getNReducer()), memo, leaves);
+
+  // Every factor holds v_size elements, their product is the result
+  std::vector<std::vector<BigNumber>> factors;
+
+  if (form.terms.size() >= IPCL_EXPR_MULTI_EXP_TERMS) {
+    // Many CipherTexts, one multi-exponentiation per element. Negative
+    // weights go into a second one with their magnitudes, which is
+    // inverted afterwards.
+    std::vector<std::vector<BigNumber>> base, exp;
+    bool has_neg = false;
+    for (const auto& term : form.terms) {
+      base.push_back(expand(term.first->leaf->getTexts(), v_size));
+      exp.push_back(expand(term.second, v_size));
+      for (const BigNumber& w : term.second)
+        if (w < BigNumber::Zero()) has_neg = true;
+    }
+
+    std::vector<BigNumber> res(v_size), neg(v_size, BigNumber::One());
+    const MontContext& ctx = *(pk.getNSQMont());
+#ifdef IPCL_USE_OMP
+    int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, v_size))
+#endif  // IPCL_USE_OMP
+    for (std::size_t i = 0; i < v_size; i++) {
+      std::vector<BigNumber> b_pos, e_pos, b_neg, e_neg;
+      for (std::size_t j = 0; j < base.size(); j++) {
+        if (exp[j][i] < BigNumber::Zero()) {
+          b_neg.push_back(base[j][i]);
+          e_neg.push_back(BigNumber::Zero() - exp[j][i]);
+        } else {
+          b_pos.push_back(base[j][i]);
+          e_pos.push_back(exp[j][i]);
+        }
+      }
+      res[i] = b_pos.empty() ? BigNumber::One() : multiExp(b_pos, e_pos, ctx);
+      if (!b_neg.empty()) neg[i] = multiExp(b_neg, e_neg, ctx);
+    }
+    factors.push_back(std::move(res));
+    if (has_neg) factors.push_back(batchInverse(neg, ctx));
+  } else {
+    // Few CipherTexts, all exponentiations go out as one batch so that the
+    // mb8 or QAT batches are full, weights of 1 need no exponentiation
+    std::vector<BigNumber> base, exp;
+    for (const auto& term : form.terms) {
+      std::vector<BigNumber> texts =
+          expand(term.first->leaf->getTexts(), v_size);
+      if (isOne(term.second)) {
+        factors.push_back(std::move(texts));
+      } else {
+        std::vector<BigNumber> w = expand(term.second, v_size);
+        base.insert(base.end(), texts.begin(), texts.end());
+        exp.insert(exp.end(), w.begin(), w.end());
+      }
+    }
+
+    if (!base.empty()) {
+      std::vector<BigNumber> powers =
+          (CipherText(pk, base) * PlainText(exp)).getTexts();
+      for (std::size_t k = 0; k < powers.size(); k += v_size)
+        factors.emplace_back(powers.begin() + k, powers.begin() + k + v_size);
+    }
+  }
+
+  std::vector<BigNumber> res = std::move(factors.front());
+  const ModMulEngine& engine = *(pk.getNSQMulEngine());
+  for (std::size_t k = 1; k < factors.size(); k++)
+    engine.modMul(res, res, factors[k]);
+
+  // Plaintext offsets are added once by the fused CT + PT kernel
+  CipherText ct(pk, res);
+  if (!form.offset.empty()) ct = ct + PlainText(form.offset);
+  return ct;
+}
+
+CipherExpr operator+(const PlainText& pt, const CipherExpr& expr) {
+  return expr + pt;
+}
+
+CipherExpr operator*(const PlainText& pt, const CipherExpr& expr) {
+  return expr * pt;
+}
+
+}  // namespace ipcl
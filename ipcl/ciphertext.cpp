@@ -4,14 +4,126 @@
 #include "ipcl/ciphertext.hpp"
 
 #include <algorithm>
+#include <map>
+#include <utility>
 
+#include "ipcl/cipher_expr.hpp"
 #include "ipcl/mod_exp.hpp"
+#include "ipcl/mod_inv.hpp"
+#include "ipcl/multi_exp.hpp"
 #include "ipcl/ipcl.hpp"
 
 #include <cereal/archives/json.hpp>
 #include <fstream>
 
 namespace ipcl {
+
+namespace {
+
+/**
+ * Replace every exponent by its magnitude as a signed value modulo n, which
+ * is short for negative plaintexts whether they are given as -|m| or encoded
+ * as n - |m|. Returns which exponents were negative.
+ */
+std::vector<bool> toMagnitudes(std::vector<BigNumber>& exp,
+                               const BigNumber& n) {
+  const BigNumber half = n / 2;
+  std::vector<bool> neg(exp.size(), false);
+  for (std::size_t i = 0; i < exp.size(); i++) {
+    if (exp[i] < BigNumber::Zero()) {
+      exp[i] = BigNumber::Zero() - exp[i];
+      neg[i] = true;
+    } else if (exp[i] > half && exp[i] < n) {
+      exp[i] = n - exp[i];
+      neg[i] = true;
+    }
+  }
+  return neg;
+}
+
+/**
+ * Inverses of Montgomery-form elements x * R mod n^2. batchInverse gives
+ * x^(-1) * R^(-1), two conversions restore the Montgomery form.
+ */
+std::vector<BigNumber> montInverse(const std::vector<BigNumber>& a,
+                                   const PublicKey& pk) {
+  std::vector<BigNumber> inv = batchInverse(a, *(pk.getNSQMont()));
+  pk.getNSQMulEngine()->toMont(inv, inv);
+  pk.getNSQMulEngine()->toMont(inv, inv);
+  return inv;
+}
+
+/**
+ * The neutral element, 1 or its Montgomery form, repeated size times
+ */
+std::vector<BigNumber> identity(std::size_t size, const PublicKey& pk,
+                                bool mont) {
+  std::vector<BigNumber> one(size, BigNumber::One());
+  if (mont) pk.getNSQMulEngine()->toMont(one, one);
+  return one;
+}
+
+/**
+ * res[r] = res[r] * den[r]^(-1) mod n^2 for the listed rows, all inversions
+ * share one batchInverse
+ */
+void divideRows(std::vector<BigNumber>& res, const std::vector<BigNumber>& den,
+                const std::vector<std::size_t>& rows, const PublicKey& pk,
+                bool mont) {
+  if (rows.empty()) return;
+  std::vector<BigNumber> num(rows.size()), inv(rows.size());
+  for (std::size_t k = 0; k < rows.size(); k++) {
+    num[k] = res[rows[k]];
+    inv[k] = den[rows[k]];
+  }
+  inv = mont ? montInverse(inv, pk) : batchInverse(inv, *(pk.getNSQMont()));
+  if (mont)
+    pk.getNSQMulEngine()->montMul(num, num, inv);
+  else
+    pk.getNSQMulEngine()->modMul(num, num, inv);
+  for (std::size_t k = 0; k < rows.size(); k++) res[rows[k]] = num[k];
+}
+
+/**
+ * Matrix-vector product with signed entries. mag and neg are the result of
+ * toMagnitudes on mat.values. The positive and the negative entries run as
+ * two matVecExp calls, the rows with negative entries are then divided by
+ * the second product.
+ */
+std::vector<BigNumber> signedMatVec(const std::vector<BigNumber>& base,
+                                    const CSRMatrix& mat,
+                                    const std::vector<BigNumber>& mag,
+                                    const std::vector<bool>& neg,
+                                    const PublicKey& pk, bool mont) {
+  CSRMatrix pos_mat, neg_mat;
+  pos_mat.rows = neg_mat.rows = mat.rows;
+  pos_mat.cols = neg_mat.cols = mat.cols;
+  pos_mat.row_ptr.push_back(0);
+  neg_mat.row_ptr.push_back(0);
+  std::vector<std::size_t> neg_rows;
+  for (std::size_t r = 0; r < mat.rows; r++) {
+    for (std::size_t k = mat.row_ptr[r]; k < mat.row_ptr[r + 1]; k++) {
+      CSRMatrix& dst = neg[k] ? neg_mat : pos_mat;
+      dst.col_idx.push_back(mat.col_idx[k]);
+      dst.values.push_back(mag[k]);
+    }
+    if (neg_mat.values.size() > neg_mat.row_ptr.back()) neg_rows.push_back(r);
+    pos_mat.row_ptr.push_back(pos_mat.values.size());
+    neg_mat.row_ptr.push_back(neg_mat.values.size());
+  }
+
+  const MontContext& ctx = *(pk.getNSQMont());
+  const MontDomain* dom =
+      mont ? &pk.getNSQMulEngine()->getMontDomain() : nullptr;
+  std::vector<BigNumber> res = pos_mat.values.empty()
+                                   ? identity(mat.rows, pk, mont)
+                                   : matVecExp(base, pos_mat, ctx, dom);
+  divideRows(res, matVecExp(base, neg_mat, ctx, dom), neg_rows, pk, mont);
+  return res;
+}
+
+}  // namespace
+
 CipherText::CipherText(const PublicKey& pk, const uint32_t& n)
     : BaseText(n), m_pk(std::make_shared<PublicKey>(pk)) {}
 
@@ -26,11 +138,15 @@ CipherText::CipherText(const PublicKey& pk, const std::vector<BigNumber>& bn_v)
 
 CipherText::CipherText(const CipherText& ct) : BaseText(ct) {
   this->m_pk = ct.m_pk;
+  this->m_fixed_base = ct.m_fixed_base;
+  this->m_mont = ct.m_mont;
 }
 
 CipherText& CipherText::operator=(const CipherText& other) {
   BaseText::operator=(other);
   this->m_pk = other.m_pk;
+  this->m_fixed_base = other.m_fixed_base;
+  this->m_mont = other.m_mont;
 
   return *this;
 }
@@ -46,74 +162,384 @@ CipherText CipherText::operator+(const CipherText& other) const {
   const auto& a = *this;
   const auto& b = other;
 
+  if (m_mont || other.m_mont) {
+    // Stay in the Montgomery domain, one Montgomery product per element
+    const ModMulEngine& engine = *(m_pk->getNSQMulEngine());
+    std::vector<BigNumber> conv, sum;
+    if (!m_mont) engine.toMont(conv, a.m_texts);
+    if (!other.m_mont) engine.toMont(conv, b.m_texts);
+    engine.montMul(sum, m_mont ? a.m_texts : conv,
+                   other.m_mont ? b.m_texts : conv);
+
+    CipherText res(*m_pk, sum);
+    res.m_mont = true;
+    return res;
+  }
+
   if (m_size == 1) {
-    BigNumber sum = a.raw_add(a.m_texts.front(), b.getTexts().front());
+    BigNumber sum;
+    a.raw_add(sum, a.m_texts.front(), b.m_texts.front());
     return CipherText(*m_pk, sum);
   } else {
-    std::vector<BigNumber> sum(m_size);
-
-    if (b_size == 1) {
-// add vector by scalar
-#ifdef IPCL_USE_OMP
-      int omp_remaining_threads = OMPUtilities::MaxThreads;
-#pragma omp parallel for num_threads( \
-    OMPUtilities::assignOMPThreads(omp_remaining_threads, m_size))
-#endif  // IPCL_USE_OMP
-      for (std::size_t i = 0; i < m_size; i++)
-        sum[i] = a.raw_add(a.m_texts[i], b.m_texts[0]);
-    } else {
-// add vector by vector
-#ifdef IPCL_USE_OMP
-      int omp_remaining_threads = OMPUtilities::MaxThreads;
-#pragma omp parallel for num_threads( \
-    OMPUtilities::assignOMPThreads(omp_remaining_threads, m_size))
-#endif  // IPCL_USE_OMP
-      for (std::size_t i = 0; i < m_size; i++)
-        sum[i] = a.raw_add(a.m_texts[i], b.m_texts[i]);
-    }
+    // Batched Montgomery multiplication by n^2, 8 lanes at a time on
+    // AVX-512 IFMA capable CPUs
+    std::vector<BigNumber> sum;
+    m_pk->getNSQMulEngine()->modMul(sum, a.m_texts, b.m_texts);
     return CipherText(*m_pk, sum);
   }
 }
 
 // CT + PT
 CipherText CipherText::operator+(const PlainText& other) const {
-  // convert PT to CT
-  CipherText b = this->m_pk->encrypt(other, false);
-  // calculate CT + CT
-  return this->operator+(b);
+  std::size_t b_size = other.getSize();
+  ERROR_CHECK(this->m_size == b_size || b_size == 1,
+              "CT + PT error: Size mismatch!");
+
+  // c * (1 + m * n) mod n^2 with g^m built in place of a full encryption,
+  // the product runs on the batched Montgomery engine
+  std::vector<BigNumber> g;
+  m_pk->powG(g, other.getTexts());
+
+  // The product is linear in c, so Montgomery operands give the Montgomery
+  // form of the sum
+  std::vector<BigNumber> sum;
+  m_pk->getNSQMulEngine()->modMul(sum, m_texts, g);
+
+  CipherText res(*m_pk, sum);
+  res.m_mont = m_mont;
+  return res;
+}
+
+// CT-CT
+CipherText CipherText::operator-(const CipherText& other) const {
+  std::size_t b_size = other.getSize();
+  ERROR_CHECK(this->m_size == b_size || b_size == 1,
+              "CT - CT error: Size mismatch!");
+  ERROR_CHECK(*(m_pk->getN()) == *(other.m_pk->getN()),
+              "CT - CT error: 2 different public keys detected!");
+
+  // a * b^(-1), the inversions of all elements share one extended GCD
+  return this->operator+(-other);
+}
+
+// CT - PT
+CipherText CipherText::operator-(const PlainText& other) const {
+  const BigNumber& n = *(m_pk->getN());
+  std::vector<BigNumber> neg = other.getTexts();
+  for (auto& x : neg) x = n.InverseAdd(x);
+  return this->operator+(PlainText(neg));
+}
+
+// -CT
+CipherText CipherText::operator-() const {
+  if (m_mont) {
+    CipherText res(*m_pk, montInverse(m_texts, *m_pk));
+    res.m_mont = true;
+    return res;
+  }
+
+  return CipherText(*m_pk, batchInverse(m_texts, *(m_pk->getNSQMont())));
 }
 
 // CT * PT
 CipherText CipherText::operator*(const PlainText& other) const {
   std::size_t b_size = other.getSize();
-  ERROR_CHECK(this->m_size == b_size || b_size == 1,
+  ERROR_CHECK(this->m_size == b_size || b_size == 1 || this->m_size == 1,
               "CT * PT error: Size mismatch!");
 
   const auto& a = *this;
-  const auto& b = other;
 
-  if (m_size == 1) {
-    BigNumber product = a.raw_mul(a.m_texts.front(), b.getTexts().front());
-    return CipherText(*m_pk, product);
+  // Negative plaintexts run with their short magnitude, the powers are
+  // inverted afterwards
+  std::vector<BigNumber> b = other.getTexts();
+  std::vector<bool> neg = toMagnitudes(b, *(m_pk->getN()));
+
+  std::vector<BigNumber> product;
+  if (m_mont) {
+    // Powers of Montgomery elements stay in the Montgomery domain, the comb
+    // tables of precompute hold normal-form bases and are not used
+    std::vector<BigNumber> a_v = a.m_texts;
+    if (m_size == 1 && b_size > 1) a_v.assign(b_size, a.m_texts.front());
+    m_pk->getNSQMulEngine()->montPow(product, a_v, b);
+  } else if (m_fixed_base) {
+    product = a.fixed_base_mul(b);
+  } else if (m_size == 1 && b_size == 1) {
+    product = {a.raw_mul(a.m_texts.front(), b.front())};
+  } else if (b_size == 1) {
+    // multiply vector by scalar
+    std::vector<BigNumber> b_v(a.m_size, b.front());
+    product = a.raw_mul(a.m_texts, b_v);
+  } else if (m_size == 1) {
+    // multiply scalar by vector
+    std::vector<BigNumber> a_v(b_size, a.m_texts.front());
+    product = a.raw_mul(a_v, b);
+  } else {
+    // multiply vector by vector
+    product = a.raw_mul(a.m_texts, b);
+  }
+
+  // c^(-|m|) = (c^|m|)^(-1), all inversions share one extended GCD
+  std::vector<std::size_t> inv_idx;
+  for (std::size_t i = 0; i < product.size(); i++)
+    if (neg[b_size == 1 ? 0 : i]) inv_idx.push_back(i);
+  if (!inv_idx.empty()) {
+    std::vector<BigNumber> inv(inv_idx.size());
+    for (std::size_t k = 0; k < inv_idx.size(); k++)
+      inv[k] = product[inv_idx[k]];
+    inv = m_mont ? montInverse(inv, *m_pk)
+                 : batchInverse(inv, *(m_pk->getNSQMont()));
+    for (std::size_t k = 0; k < inv_idx.size(); k++)
+      product[inv_idx[k]] = inv[k];
+  }
+
+  CipherText res(*m_pk, product);
+  res.m_mont = m_mont;
+  return res;
+}
+
+CipherExpr CipherText::lazy() const { return CipherExpr(*this); }
+
+void CipherText::precompute(int window, int exp_bits) {
+  ERROR_CHECK(m_size > 0, "precompute: Cannot precompute empty CipherText");
+  if (exp_bits <= 0) exp_bits = m_pk->getN()->BitSize();
+
+  std::shared_ptr<const ModMulEngine> engine = m_pk->getNSQMulEngine();
+  std::vector<std::shared_ptr<const FixedBaseTable>> tables(m_size);
+  std::vector<BigNumber> texts = getTexts();
+
+#ifdef IPCL_USE_OMP
+  int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, m_size))
+#endif  // IPCL_USE_OMP
+  for (std::size_t i = 0; i < m_size; i++)
+    tables[i] =
+        std::make_shared<FixedBaseTable>(texts[i], exp_bits, window, engine);
+
+  if (!m_fixed_base) m_fixed_base = std::make_shared<FixedBaseCache>();
+  for (std::size_t i = 0; i < m_size; i++) m_fixed_base->insert(i, tables[i]);
+}
+
+CipherText CipherText::sum() const {
+  ERROR_CHECK(m_size > 0, "sum: Cannot sum empty CipherText");
+
+  CipherText res(*m_pk, m_pk->getNSQMulEngine()->product(m_texts, m_mont));
+  res.m_mont = m_mont;
+  return res;
+}
+
+CipherText CipherText::sum(const std::vector<CipherText>& cts) {
+  ERROR_CHECK(!cts.empty(), "sum: Cannot sum empty CipherText vector");
+
+  const CipherText& first = cts.front();
+  std::size_t v_size = first.m_size;
+  std::size_t ct_num = cts.size();
+  for (const auto& ct : cts) {
+    ERROR_CHECK(ct.m_size == v_size, "sum: Size mismatch!");
+    ERROR_CHECK(*(ct.m_pk->getN()) == *(first.m_pk->getN()),
+                "sum: different public keys detected!");
+  }
+
+  const ModMulEngine& engine = *(first.m_pk->getNSQMulEngine());
+
+  // One Montgomery operand keeps the sum in Montgomery form, the normal-form
+  // operands are converted once
+  bool mont = std::any_of(cts.begin(), cts.end(),
+                          [](const CipherText& ct) { return ct.m_mont; });
+  std::vector<std::vector<BigNumber>> conv(ct_num);
+  for (std::size_t k = 0; k < ct_num; k++)
+    if (mont && !cts[k].m_mont) engine.toMont(conv[k], cts[k].m_texts);
+  auto texts = [&](std::size_t k) -> const std::vector<BigNumber>& {
+    return (mont && !cts[k].m_mont) ? conv[k] : cts[k].m_texts;
+  };
+
+  std::vector<BigNumber> sum;
+  if (v_size < ct_num) {
+    // Few long columns, reduce each column with the tree reduction
+    sum.resize(v_size);
+    std::vector<BigNumber> column(ct_num);
+    for (std::size_t i = 0; i < v_size; i++) {
+      for (std::size_t k = 0; k < ct_num; k++) column[k] = texts(k)[i];
+      sum[i] = engine.product(column, mont);
+    }
   } else {
-    std::vector<BigNumber> product;
-    if (b_size == 1) {
-      // multiply vector by scalar
-      std::vector<BigNumber> b_v(a.m_size, b.getElement(0));
-      product = a.raw_mul(a.m_texts, b_v);
-    } else {
-      // multiply vector by vector
-      product = a.raw_mul(a.m_texts, b.getTexts());
+    // Wide rows, accumulate in place with batched multiplications
+    sum = texts(0);
+    for (std::size_t k = 1; k < ct_num; k++) {
+      if (mont)
+        engine.montMul(sum, sum, texts(k));
+      else
+        engine.modMul(sum, sum, texts(k));
     }
-    return CipherText(*m_pk, product);
   }
+
+  CipherText res(*(first.m_pk), sum);
+  res.m_mont = mont;
+  return res;
+}
+
+CipherText CipherText::dot(const PlainText& weights) const {
+  ERROR_CHECK(m_size > 0, "dot: Cannot compute with empty CipherText");
+  ERROR_CHECK(weights.getSize() == m_size, "dot: Size mismatch!");
+
+  // Negative weights run with their short magnitudes in a second
+  // multi-exponentiation, which is inverted afterwards
+  std::vector<BigNumber> w = weights.getTexts();
+  std::vector<bool> neg = toMagnitudes(w, *(m_pk->getN()));
+  std::vector<BigNumber> b_pos, w_pos, b_neg, w_neg;
+  for (std::size_t i = 0; i < m_size; i++) {
+    (neg[i] ? b_neg : b_pos).push_back(m_texts[i]);
+    (neg[i] ? w_neg : w_pos).push_back(w[i]);
+  }
+
+  // Montgomery elements enter and leave multiExp in their own form
+  const MontContext& ctx = *(m_pk->getNSQMont());
+  const MontDomain* dom =
+      m_mont ? &m_pk->getNSQMulEngine()->getMontDomain() : nullptr;
+  std::vector<BigNumber> res = b_pos.empty()
+                                   ? identity(1, *m_pk, m_mont)
+                                   : std::vector<BigNumber>{
+                                         multiExp(b_pos, w_pos, ctx, dom)};
+  if (!b_neg.empty())
+    divideRows(res, {multiExp(b_neg, w_neg, ctx, dom)}, {0}, *m_pk, m_mont);
+
+  CipherText ct(*m_pk, res);
+  ct.m_mont = m_mont;
+  return ct;
+}
+
+CipherText CipherText::matVec(const DenseMatrix& mat) const {
+  ERROR_CHECK(mat.rows > 0, "matVec: Cannot multiply empty matrix");
+  ERROR_CHECK(mat.cols == m_size, "matVec: Size mismatch!");
+
+  std::vector<BigNumber> mag = mat.values;
+  std::vector<bool> neg = toMagnitudes(mag, *(m_pk->getN()));
+  std::vector<BigNumber> res;
+  if (std::none_of(neg.begin(), neg.end(), [](bool b) { return b; })) {
+    const MontDomain* dom =
+        m_mont ? &m_pk->getNSQMulEngine()->getMontDomain() : nullptr;
+    res = matVecExp(m_texts, mat, *(m_pk->getNSQMont()), dom);
+  } else {
+    // Signed entries go through the CSR split, zero entries included
+    ERROR_CHECK(mat.values.size() == mat.rows * mat.cols,
+                "matVec: dense matrix size mismatch");
+    CSRMatrix csr;
+    csr.rows = mat.rows;
+    csr.cols = mat.cols;
+    for (std::size_t r = 0; r <= mat.rows; r++)
+      csr.row_ptr.push_back(r * mat.cols);
+    for (std::size_t r = 0; r < mat.rows; r++)
+      for (std::size_t j = 0; j < mat.cols; j++) csr.col_idx.push_back(j);
+    res = signedMatVec(m_texts, csr, mag, neg, *m_pk, m_mont);
+  }
+
+  CipherText ct(*m_pk, res);
+  ct.m_mont = m_mont;
+  return ct;
+}
+
+CipherText CipherText::matVec(const CSRMatrix& mat) const {
+  ERROR_CHECK(mat.rows > 0, "matVec: Cannot multiply empty matrix");
+  ERROR_CHECK(mat.cols == m_size, "matVec: Size mismatch!");
+
+  std::vector<BigNumber> mag = mat.values;
+  std::vector<bool> neg = toMagnitudes(mag, *(m_pk->getN()));
+  std::vector<BigNumber> res;
+  if (std::none_of(neg.begin(), neg.end(), [](bool b) { return b; })) {
+    const MontDomain* dom =
+        m_mont ? &m_pk->getNSQMulEngine()->getMontDomain() : nullptr;
+    res = matVecExp(m_texts, mat, *(m_pk->getNSQMont()), dom);
+  } else {
+    // Column indices are checked again by matVecExp on both halves
+    ERROR_CHECK(mat.row_ptr.size() == mat.rows + 1 && mat.row_ptr[0] == 0 &&
+                    mat.row_ptr.back() == mat.values.size() &&
+                    mat.col_idx.size() == mat.values.size(),
+                "matVec: malformed CSR matrix");
+    for (std::size_t r = 0; r < mat.rows; r++)
+      ERROR_CHECK(mat.row_ptr[r] <= mat.row_ptr[r + 1],
+                  "matVec: CSR row pointer is not sorted");
+    res = signedMatVec(m_texts, mat, mag, neg, *m_pk, m_mont);
+  }
+
+  CipherText ct(*m_pk, res);
+  ct.m_mont = m_mont;
+  return ct;
 }
 
 CipherText CipherText::getCipherText(const size_t& idx) const {
   ERROR_CHECK((idx >= 0) && (idx < m_size),
               "CipherText::getCipherText index is out of range");
 
-  return CipherText(*m_pk, m_texts[idx]);
+  CipherText res(*m_pk, m_texts[idx]);
+  res.m_mont = m_mont;
+  return res;
+}
+
+CipherText CipherText::toMontgomery() const {
+  if (m_mont) return *this;
+
+  CipherText res(*this);
+  m_pk->getNSQMulEngine()->toMont(res.m_texts, m_texts);
+  res.m_mont = true;
+  return res;
+}
+
+CipherText CipherText::fromMontgomery() const {
+  if (!m_mont) return *this;
+
+  CipherText res(*this);
+  m_pk->getNSQMulEngine()->fromMont(res.m_texts, m_texts);
+  res.m_mont = false;
+  return res;
+}
+
+BigNumber CipherText::getElement(const std::size_t& idx) const {
+  BigNumber bn = BaseText::getElement(idx);
+  if (!m_mont) return bn;
+
+  std::vector<BigNumber> v{bn};
+  m_pk->getNSQMulEngine()->fromMont(v, v);
+  return v.front();
+}
+
+BigNumber& CipherText::operator[](const std::size_t idx) {
+  ERROR_CHECK(!m_mont,
+              "CipherText: operator[] needs the normal form, call "
+              "fromMontgomery first");
+  return BaseText::operator[](idx);
+}
+
+void CipherText::insert(const std::size_t pos, BigNumber& bn) {
+  if (!m_mont) {
+    BaseText::insert(pos, bn);
+    return;
+  }
+  std::vector<BigNumber> v{bn};
+  m_pk->getNSQMulEngine()->toMont(v, v);
+  BaseText::insert(pos, v.front());
+}
+
+std::vector<uint32_t> CipherText::getElementVec(const std::size_t& idx) const {
+  std::vector<uint32_t> v;
+  getElement(idx).num2vec(v);
+  return v;
+}
+
+std::string CipherText::getElementHex(const std::size_t& idx) const {
+  std::string s;
+  getElement(idx).num2hex(s);
+  return s;
+}
+
+std::vector<BigNumber> CipherText::getChunk(const std::size_t& start,
+                                            const std::size_t& size) const {
+  std::vector<BigNumber> v = BaseText::getChunk(start, size);
+  if (m_mont) m_pk->getNSQMulEngine()->fromMont(v, v);
+  return v;
+}
+
+std::vector<BigNumber> CipherText::getTexts() const {
+  return m_mont ? fromMontgomery().m_texts : m_texts;
 }
 
 std::shared_ptr<PublicKey> CipherText::getPubKey() const { return m_pk; }
@@ -123,25 +549,29 @@ CipherText CipherText::rotate(int shift) const {
   ERROR_CHECK(shift >= (-1) * static_cast<int>(m_size) && shift <= m_size,
               "rotate: Cannot shift more than the test size");
 
+  // Elements are only moved, the Montgomery form is kept
+  CipherText res(*m_pk, m_texts);
+  res.m_mont = m_mont;
+
   if (shift == 0 || shift == m_size || shift == (-1) * static_cast<int>(m_size))
-    return CipherText(*m_pk, m_texts);
+    return res;
 
   if (shift > 0)
     shift = m_size - shift;
   else
     shift = -shift;
 
-  std::vector<BigNumber> new_bn = getTexts();
-  std::rotate(std::begin(new_bn), std::begin(new_bn) + shift, std::end(new_bn));
-  return CipherText(*m_pk, new_bn);
+  std::rotate(std::begin(res.m_texts), std::begin(res.m_texts) + shift,
+              std::end(res.m_texts));
+  return res;
 }
 
-BigNumber CipherText::raw_add(const BigNumber& a, const BigNumber& b) const {
-  // Hold a copy of nsquare for multi-threaded
-  // The BigNumber % operator is not thread safe
-  // const BigNumber& sq = *(m_pk->getNSQ());
-  const BigNumber sq = *(m_pk->getNSQ());
-  return a * b % sq;
+void CipherText::raw_add(BigNumber& out, const BigNumber& a,
+                         const BigNumber& b) const {
+  // Montgomery multiplication with the fixed-size kernels of n^2 avoids the
+  // 8192-bit product and the division, and writes straight into out. The
+  // context is read only, so it is safe to share between threads.
+  mulmod_into(out, a, b, *(m_pk->getNSQMont()));
 }
 
 BigNumber CipherText::raw_mul(const BigNumber& a, const BigNumber& b) const {
@@ -152,7 +582,6 @@ BigNumber CipherText::raw_mul(const BigNumber& a, const BigNumber& b) const {
 std::vector<BigNumber> CipherText::raw_mul(
     const std::vector<BigNumber>& a, const std::vector<BigNumber>& b) const {
   std::size_t v_size = a.size();
-  std::vector<BigNumber> sq(v_size, *(m_pk->getNSQ()));
 
   // If hybrid OPTIMAL mode is used, use a special ratio
   if (isHybridOptimal()) {
@@ -162,9 +591,62 @@ std::vector<BigNumber> CipherText::raw_mul(
     setHybridRatio(qat_ratio, false);
   }
 
+  std::vector<BigNumber> sq(v_size, *(m_pk->getNSQ()));
   return modExp(a, b, sq);
 }
 
+std::vector<BigNumber> CipherText::fixed_base_mul(
+    const std::vector<BigNumber>& b) const {
+  std::size_t v_size = std::max(m_size, b.size());
+  auto base_idx = [&](std::size_t i) { return m_size == 1 ? 0 : i; };
+  auto exp = [&](std::size_t i) -> const BigNumber& {
+    return b.size() == 1 ? b.front() : b[i];
+  };
+
+  // Look up the tables once, elements whose table was evicted or whose value
+  // changed since precompute() fall back to the batched modExp
+  std::vector<std::shared_ptr<const FixedBaseTable>> tables(v_size);
+  std::vector<std::size_t> miss;
+  for (std::size_t i = 0; i < v_size; i++) {
+    if (exp(i) >= BigNumber::Zero()) {
+      std::size_t j = base_idx(i);
+      tables[i] = m_fixed_base->find(j, m_texts[j], exp(i).BitSize());
+    }
+    if (!tables[i]) miss.push_back(i);
+  }
+
+  std::vector<BigNumber> product(v_size);
+  if (!miss.empty()) {
+    std::vector<BigNumber> a_m, b_m;
+    for (std::size_t i : miss) {
+      a_m.push_back(m_texts[base_idx(i)]);
+      b_m.push_back(exp(i));
+    }
+    std::vector<BigNumber> p_m = raw_mul(a_m, b_m);
+    for (std::size_t k = 0; k < miss.size(); k++) product[miss[k]] = p_m[k];
+  }
+
+  // Tables of one precompute() call share their shape and run as one batch
+  std::map<std::pair<int, int>, std::vector<std::size_t>> groups;
+  for (std::size_t i = 0; i < v_size; i++)
+    if (tables[i])
+      groups[{tables[i]->getWindow(), tables[i]->getExpBits()}].push_back(i);
+
+  for (const auto& group : groups) {
+    const std::vector<std::size_t>& idx = group.second;
+    std::vector<const FixedBaseTable*> t_g(idx.size());
+    std::vector<BigNumber> b_g(idx.size());
+    for (std::size_t k = 0; k < idx.size(); k++) {
+      t_g[k] = tables[idx[k]].get();
+      b_g[k] = exp(idx[k]);
+    }
+    std::vector<BigNumber> p_g = FixedBaseTable::pow(t_g, b_g);
+    for (std::size_t k = 0; k < idx.size(); k++) product[idx[k]] = p_g[k];
+  }
+
+  return product;
+}
+
 }  // namespace ipcl
 
 #include "ipcl/ciphertext_c.h"
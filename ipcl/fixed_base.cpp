@@ -0,0 +1,96 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ipcl/fixed_base.hpp"
+
+#include "ipcl/utils/util.hpp"
+
+namespace ipcl {
+
+FixedBaseTable::FixedBaseTable(const BigNumber& base, int exp_bits,
+                               int window,
+                               std::shared_ptr<const ModMulEngine> engine)
+    : m_engine(engine),
+      m_base(base),
+      m_exp_bits(exp_bits),
+      m_window(window) {
+  ERROR_CHECK(window > 0 && window <= 16,
+              "FixedBaseTable: window must be between 1 and 16");
+  ERROR_CHECK(exp_bits > 0, "FixedBaseTable: exponent size must be positive");
+
+  m_spacing = (exp_bits + window - 1) / window;
+  m_table = m_engine->combTable(base, window, m_spacing);
+}
+
+BigNumber FixedBaseTable::pow(const BigNumber& exp) const {
+  return pow(std::vector<const FixedBaseTable*>{this}, {exp}).front();
+}
+
+std::vector<BigNumber> FixedBaseTable::pow(
+    const std::vector<const FixedBaseTable*>& tables,
+    const std::vector<BigNumber>& exp) {
+  ERROR_CHECK(!tables.empty() && tables.size() == exp.size(),
+              "FixedBaseTable: operand size mismatch");
+
+  const FixedBaseTable& first = *tables.front();
+  std::vector<const Ipp64u*> entries(tables.size());
+  for (std::size_t i = 0; i < tables.size(); i++) {
+    ERROR_CHECK(tables[i]->m_engine == first.m_engine &&
+                    tables[i]->m_window == first.m_window &&
+                    tables[i]->m_spacing == first.m_spacing,
+                "FixedBaseTable: tables of different shapes");
+    entries[i] = tables[i]->m_table.data();
+  }
+
+  std::vector<BigNumber> res;
+  first.m_engine->combPow(res, entries, exp, first.m_window, first.m_spacing);
+  return res;
+}
+
+FixedBaseCache::FixedBaseCache(std::size_t limit) : m_limit(limit) {}
+
+void FixedBaseCache::insert(std::size_t idx,
+                            std::shared_ptr<const FixedBaseTable> table) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  Key key(idx, table->getExpBits());
+  auto it = m_index.find(key);
+  if (it != m_index.end()) {
+    m_bytes -= it->second->second->getBytes();
+    m_lru.erase(it->second);
+    m_index.erase(it);
+  }
+
+  m_lru.emplace_front(key, table);
+  m_index[key] = m_lru.begin();
+  m_bytes += table->getBytes();
+
+  // Keep at least the newest table even if it alone exceeds the limit
+  while (m_bytes > m_limit && m_lru.size() > 1) {
+    const Entry& victim = m_lru.back();
+    m_bytes -= victim.second->getBytes();
+    m_index.erase(victim.first);
+    m_lru.pop_back();
+  }
+}
+
+std::shared_ptr<const FixedBaseTable> FixedBaseCache::find(
+    std::size_t idx, const BigNumber& base, int exp_bits) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto it = m_index.lower_bound(Key(idx, exp_bits));
+  if (it == m_index.end() || it->first.first != idx) return nullptr;
+
+  auto entry = it->second;
+  if (entry->second->getBase() != base) return nullptr;
+
+  m_lru.splice(m_lru.begin(), m_lru, entry);
+  return entry->second;
+}
+
+std::size_t FixedBaseCache::getBytes() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_bytes;
+}
+
+}  // namespace ipcl
@@ -0,0 +1,147 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ipcl/fixed_bignum.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "ipcl/utils/util.hpp"
+
+namespace ipcl {
+
+MontContext::MontContext(const BigNumber& mod)
+    : m_limbs(BITSIZE_DWORD(mod.BitSize())), m_mod_bn(mod) {
+  ERROR_CHECK(mod.IsOdd(), "MontContext: modulus must be odd");
+  ERROR_CHECK(m_limbs <= IPCL_MAX_LIMBS, "MontContext: modulus is too large");
+
+  m_mod.assign(m_limbs, 0);
+  m_r2.assign(m_limbs, 0);
+  m_one.assign(m_limbs, 0);
+
+  int bits;
+  Ipp32u* data;
+  ippsRef_BN(nullptr, &bits, &data, BN(mod));
+  std::memcpy(m_mod.data(), data, BITSIZE_WORD(bits) * sizeof(Ipp32u));
+
+  // k0 = -m^(-1) mod 2^64 by Newton iteration, each step doubles the
+  // number of correct low bits
+  Ipp64u inv = m_mod[0];
+  for (int i = 0; i < 6; i++) inv *= 2 - m_mod[0] * inv;
+  m_k0 = ~inv + 1;
+
+  std::vector<Ipp32u> r_words(m_limbs * 2 + 1, 0);
+  r_words.back() = 1;
+  BigNumber r(r_words.data(), r_words.size());
+  BigNumber r_mod = r % mod;
+  BigNumber r2 = r_mod * r_mod % mod;
+
+  ippsRef_BN(nullptr, &bits, &data, BN(r_mod));
+  std::memcpy(m_one.data(), data, BITSIZE_WORD(bits) * sizeof(Ipp32u));
+  ippsRef_BN(nullptr, &bits, &data, BN(r2));
+  std::memcpy(m_r2.data(), data, BITSIZE_WORD(bits) * sizeof(Ipp32u));
+}
+
+void MontContext::load(Ipp64u* r, const BigNumber& bn) const {
+  IppsBigNumSGN sgn;
+  int bits;
+  Ipp32u* data;
+  ippsRef_BN(&sgn, &bits, &data, BN(bn));
+
+  if (sgn == IppsBigNumNEG || BITSIZE_DWORD(bits) > m_limbs) {
+    load(r, bn % m_mod_bn);
+    return;
+  }
+
+  std::memset(r, 0, m_limbs * sizeof(Ipp64u));
+  std::memcpy(r, data, BITSIZE_WORD(bits) * sizeof(Ipp32u));
+  if (limb::cmp<0>(r, mod(), m_limbs) >= 0) load(r, bn % m_mod_bn);
+}
+
+BigNumber MontContext::store(const Ipp64u* a) const {
+  return BigNumber(reinterpret_cast<const Ipp32u*>(a), m_limbs * 2);
+}
+
+void MontContext::store(BigNumber& out, const Ipp64u* a) const {
+  out.Reserve(m_limbs * 2);
+  out.Set(reinterpret_cast<const Ipp32u*>(a), m_limbs * 2);
+}
+
+BigNumber MontContext::modMul(const BigNumber& a, const BigNumber& b) const {
+  BigNumber r;
+  mulmod_into(r, a, b, *this);
+  return r;
+}
+
+BigNumber MontContext::modAdd(const BigNumber& a, const BigNumber& b) const {
+  BigNumber r;
+  addmod_into(r, a, b, *this);
+  return r;
+}
+
+ExactDivisor::ExactDivisor(const BigNumber& d)
+    : m_limbs(BITSIZE_DWORD(d.BitSize())) {
+  ERROR_CHECK(d.IsOdd(), "ExactDivisor: divisor must be odd");
+  ERROR_CHECK(m_limbs <= IPCL_MAX_LIMBS, "ExactDivisor: divisor is too large");
+
+  std::vector<Ipp64u> dl(m_limbs, 0), t(m_limbs);
+  int bits;
+  Ipp32u* data;
+  ippsRef_BN(nullptr, &bits, &data, BN(d));
+  std::memcpy(dl.data(), data, BITSIZE_WORD(bits) * sizeof(Ipp32u));
+
+  // Newton iteration x = x * (2 - d * x), every step doubles the number of
+  // correct low bits, starting from the inverse modulo 2^64
+  m_inv.assign(m_limbs, 0);
+  Ipp64u inv = dl[0];
+  for (int i = 0; i < 6; i++) inv *= 2 - dl[0] * inv;
+  m_inv[0] = inv;
+  for (int prec = 1; prec < m_limbs; prec *= 2) {
+    limb::mulLow<0>(t.data(), dl.data(), m_inv.data(), m_limbs);
+    // 2 - t = ~t + 3
+    Ipp64u carry = 3;
+    for (int i = 0; i < m_limbs; i++) {
+      t[i] = ~t[i] + carry;
+      carry = (carry && t[i] < carry) ? 1 : 0;
+    }
+    limb::mulLow<0>(m_inv.data(), m_inv.data(), t.data(), m_limbs);
+  }
+}
+
+BigNumber ExactDivisor::divide(const BigNumber& x) const {
+  int bits;
+  Ipp32u* data;
+  ippsRef_BN(nullptr, &bits, &data, BN(x));
+
+  std::vector<Ipp64u> q(m_limbs, 0);
+  std::memcpy(q.data(), data,
+              std::min(BITSIZE_WORD(bits), 2 * m_limbs) * sizeof(Ipp32u));
+  limb::mulLow<0>(q.data(), q.data(), m_inv.data(), m_limbs);
+  return BigNumber(reinterpret_cast<const Ipp32u*>(q.data()), 2 * m_limbs);
+}
+
+void mulmod_into(BigNumber& out, const BigNumber& a, const BigNumber& b,
+                 const MontContext& ctx) {
+  dispatchLimbs(ctx.getLimbs(), [&](auto L) {
+    constexpr int N = decltype(L)::value;
+    LimbArray<N> x, y;
+    ctx.load(x.data(), a);
+    ctx.load(y.data(), b);
+    ctx.modMul<N>(x.data(), x.data(), y.data());
+    ctx.store(out, x.data());
+  });
+}
+
+void addmod_into(BigNumber& out, const BigNumber& a, const BigNumber& b,
+                 const MontContext& ctx) {
+  dispatchLimbs(ctx.getLimbs(), [&](auto L) {
+    constexpr int N = decltype(L)::value;
+    LimbArray<N> x, y;
+    ctx.load(x.data(), a);
+    ctx.load(y.data(), b);
+    ctx.modAdd<N>(x.data(), x.data(), y.data());
+    ctx.store(out, x.data());
+  });
+}
+
+}  // namespace ipcl
@@ -14,7 +14,7 @@ namespace ipcl {
 class BaseText {
  public:
   BaseText() = default;
-  ~BaseText() = default;
+  virtual ~BaseText() = default;
 
   /**
    * BaseText constructors
@@ -37,14 +37,14 @@ class BaseText {
   /**
    * Overloading [] operator to access BigNumber elements
    */
-  BigNumber& operator[](const std::size_t idx);
+  virtual BigNumber& operator[](const std::size_t idx);
 
   /**
    * Insert a big number before pos
    * @param[in] pos Position in m_texts
    * @bn[in] Big number need to be inserted
    */
-  void insert(const std::size_t pos, BigNumber& bn);
+  virtual void insert(const std::size_t pos, BigNumber& bn);
 
   /**
    * Clear all big number element
@@ -63,21 +63,21 @@ class BaseText {
    * @param[in] idx Element index
    * return Element in m_text of type BigNumber
    */
-  BigNumber getElement(const std::size_t& idx) const;
+  virtual BigNumber getElement(const std::size_t& idx) const;
 
   /**
    * Gets the specified BigNumber vector form
    * @param[in] idx Element index
    * @return Element vector form
    */
-  std::vector<uint32_t> getElementVec(const std::size_t& idx) const;
+  virtual std::vector<uint32_t> getElementVec(const std::size_t& idx) const;
 
   /**
    * Gets the specified BigNumber hex string form
    * @param[in] idx Element index
    * @return Element hex string form
    */
-  std::string getElementHex(const std::size_t& idx) const;
+  virtual std::string getElementHex(const std::size_t& idx) const;
 
   /**
    * Gets a chunk of BigNumber element in m_text
@@ -85,13 +85,13 @@ class BaseText {
    * @param[in] size The number of element
    * return A chunk of BigNumber element
    */
-  std::vector<BigNumber> getChunk(const std::size_t& start,
-                                  const std::size_t& size) const;
+  virtual std::vector<BigNumber> getChunk(const std::size_t& start,
+                                          const std::size_t& size) const;
 
   /**
    * Gets the BigNumber container
    */
-  std::vector<BigNumber> getTexts() const;
+  virtual std::vector<BigNumber> getTexts() const;
 
   /**
    * Gets the size of the BigNumber container
@@ -40,6 +40,10 @@ class BigNumber : public ipcl::serializer::serializerBase {
   // set value
   void Set(const Ipp32u* pData, int length = 1,
            IppsBigNumSGN sgn = IppsBigNumPOS);
+  // grow the storage to hold at least length 32-bit words, keeps the value
+  void Reserve(int length);
+  // capacity in 32-bit words
+  int Capacity() const;
   // conversion to IppsBigNumState
   friend IppsBigNumState* BN(const BigNumber& bn) { return bn.m_pBN; }
   operator IppsBigNumState*() const { return m_pBN; }
@@ -175,4 +179,19 @@ class BigNumber : public ipcl::serializer::serializerBase {
 constexpr int BITSIZE_WORD(int n) { return (((n) + 31) >> 5); }
 constexpr int BITSIZE_DWORD(int n) { return (((n) + 63) >> 6); }
 
+// Low-level arithmetic writing into caller-provided storage. The output only
+// grows when its capacity is too small, so reusing the same out and scratch
+// objects across calls does not allocate. out must not alias an operand.
+void add_into(BigNumber& out, const BigNumber& a, const BigNumber& b);
+void sub_into(BigNumber& out, const BigNumber& a, const BigNumber& b);
+void mul_into(BigNumber& out, const BigNumber& a, const BigNumber& b);
+// out = a mod m, always non-negative
+void mod_into(BigNumber& out, const BigNumber& a, const BigNumber& m);
+// q = a / b, r = a mod b
+void div_into(BigNumber& q, BigNumber& r, const BigNumber& a,
+              const BigNumber& b);
+// out = a * b mod m, scratch holds the double width product
+void mulmod_into(BigNumber& out, const BigNumber& a, const BigNumber& b,
+                 const BigNumber& m, BigNumber& scratch);
+
 #endif  // _BIGNUM_H_
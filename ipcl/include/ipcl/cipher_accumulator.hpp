@@ -0,0 +1,72 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef IPCL_INCLUDE_IPCL_CIPHER_ACCUMULATOR_HPP_
+#define IPCL_INCLUDE_IPCL_CIPHER_ACCUMULATOR_HPP_
+
+#include <memory>
+#include <vector>
+
+#include "ipcl/ciphertext.hpp"
+#include "ipcl/pub_key.hpp"
+
+namespace ipcl {
+
+/**
+ * Running homomorphic sum of many CipherTexts of the same size. The products
+ * mod n^2 are kept in the internal representation of ModMulEngine, so the
+ * absorbed elements are neither converted to the Montgomery domain nor fully
+ * reduced, the pending factors and the final reduction are applied once by
+ * getCipherText(). Accumulators are not thread safe, concurrent producers use
+ * one accumulator each and merge them at the end.
+ */
+class CipherAccumulator {
+ public:
+  /**
+   * CipherAccumulator constructor
+   * @param[in] pk public key of the accumulated CipherTexts
+   * @param[in] size number of elements of the accumulated CipherTexts
+   */
+  CipherAccumulator(const PublicKey& pk, std::size_t size);
+
+  /**
+   * Add a CipherText of the accumulator size or of size 1
+   */
+  void add(const CipherText& ct);
+
+  CipherAccumulator& operator+=(const CipherText& ct) {
+    add(ct);
+    return *this;
+  }
+
+  /**
+   * Add the sum of another accumulator with the same public key and size
+   */
+  void merge(const CipherAccumulator& other);
+
+  /**
+   * Reduced sum of the CipherTexts added so far, the accumulator keeps
+   * its state
+   */
+  CipherText getCipherText() const;
+
+  /**
+   * Number of elements
+   */
+  std::size_t getSize() const { return m_size; }
+
+  /**
+   * Number of CipherTexts added so far, merged ones included
+   */
+  std::size_t getCount() const { return m_count; }
+
+ private:
+  std::shared_ptr<PublicKey> m_pk;
+  std::size_t m_size;
+  std::size_t m_count = 0;
+  std::size_t m_shift = 0;    ///< Pending Montgomery factors R^(-1)
+  std::vector<Ipp64u> m_acc;  ///< Running products, see ModMulEngine::accInit
+};
+
+}  // namespace ipcl
+#endif  // IPCL_INCLUDE_IPCL_CIPHER_ACCUMULATOR_HPP_
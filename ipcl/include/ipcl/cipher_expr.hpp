@@ -0,0 +1,68 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef IPCL_INCLUDE_IPCL_CIPHER_EXPR_HPP_
+#define IPCL_INCLUDE_IPCL_CIPHER_EXPR_HPP_
+
+#include <memory>
+
+#include "ipcl/ciphertext.hpp"
+#include "ipcl/plaintext.hpp"
+
+namespace ipcl {
+
+/**
+ * Below this many distinct CipherTexts an expression runs all its
+ * exponentiations as one modExp batch and multiplies the results, above it
+ * every element is evaluated as one multi-exponentiation
+ */
+constexpr std::size_t IPCL_EXPR_MULTI_EXP_TERMS = 8;
+
+/**
+ * Lazily evaluated homomorphic expression over CipherText and PlainText.
+ * Operators only record a node of the expression graph. eval() folds the
+ * graph into prod(c_j^w_j) * (1 + m * n) mod n^2, merging repeated
+ * CipherTexts and plaintext offsets, and computes it without materializing
+ * any intermediate CipherText. Sizes follow the CipherText operators, an
+ * operand of size 1 is broadcast.
+ */
+class CipherExpr {
+ public:
+  /**
+   * Leaf expression holding a CipherText
+   */
+  explicit CipherExpr(const CipherText& ct);
+
+  // CT+CT
+  CipherExpr operator+(const CipherExpr& other) const;
+  CipherExpr operator+(const CipherText& other) const;
+  // CT+PT
+  CipherExpr operator+(const PlainText& other) const;
+  // CT*PT
+  CipherExpr operator*(const PlainText& other) const;
+
+  /**
+   * Evaluate the expression
+   */
+  CipherText eval() const;
+
+  /**
+   * Number of elements of the result
+   */
+  std::size_t getSize() const;
+
+  struct Node;
+
+ private:
+  explicit CipherExpr(std::shared_ptr<const Node> node);
+
+  std::shared_ptr<const Node> m_node;  ///< Root of the expression graph
+};
+
+// PT+CT
+CipherExpr operator+(const PlainText& pt, const CipherExpr& expr);
+// PT*CT
+CipherExpr operator*(const PlainText& pt, const CipherExpr& expr);
+
+}  // namespace ipcl
+#endif  // IPCL_INCLUDE_IPCL_CIPHER_EXPR_HPP_
@@ -5,8 +5,11 @@
 #define IPCL_INCLUDE_IPCL_CIPHERTEXT_HPP_
 
 #include <memory>
+#include <string>
 #include <vector>
 
+#include "ipcl/fixed_base.hpp"
+#include "ipcl/plain_matrix.hpp"
 #include "ipcl/plaintext.hpp"
 #include "ipcl/pub_key.hpp"
 #include "ipcl/utils/util.hpp"
@@ -17,6 +20,8 @@
 
 namespace ipcl {
 
+class CipherExpr;
+
 class CipherText : public BaseText {
  public:
   CipherText() = default;
@@ -43,9 +48,121 @@ class CipherText : public BaseText {
   CipherText operator+(const CipherText& other) const;
   // CT+PT
   CipherText operator+(const PlainText& other) const;
-  // CT*PT
+  // CT-CT, a * b^(-1) mod n^2 with the inversions batched
+  CipherText operator-(const CipherText& other) const;
+  // CT-PT
+  CipherText operator-(const PlainText& other) const;
+  // -CT, c^(-1) mod n^2
+  CipherText operator-() const;
+  // CT*PT, a CipherText of size 1 is broadcast over all plaintexts.
+  // Negative plaintexts, given as -|m| or encoded as n - |m|, are raised to
+  // the short |m| and inverted in one batch.
   CipherText operator*(const PlainText& other) const;
 
+  /**
+   * Start a lazily evaluated expression with this CipherText, see CipherExpr
+   */
+  CipherExpr lazy() const;
+
+  /**
+   * Build fixed-base comb tables of the elements for later CT * PT products,
+   * which then use them automatically. Tables are shared by copies of this
+   * CipherText and evicted least recently used first beyond
+   * IPCL_FIXED_BASE_CACHE_BYTES.
+   * @param[in] window comb width, every table holds 2^window entries of n^2
+   * @param[in] exp_bits largest plaintext bit length served, the bit length
+   * of n when 0
+   */
+  void precompute(int window = IPCL_FIXED_BASE_WINDOW, int exp_bits = 0);
+
+  /**
+   * Get the cache of fixed-base tables, nullptr before precompute()
+   */
+  std::shared_ptr<const FixedBaseCache> getFixedBaseCache() const {
+    return m_fixed_base;
+  }
+
+  /**
+   * Homomorphic sum of all elements, computed as a parallel tree reduction
+   * of the product mod n^2
+   * @return CipherText of size 1
+   */
+  CipherText sum() const;
+
+  /**
+   * Element-wise homomorphic sum of many CipherTexts of the same size and
+   * public key
+   * @param[in] cts CipherTexts to be summed
+   * @return CipherText of the common size
+   */
+  static CipherText sum(const std::vector<CipherText>& cts);
+
+  /**
+   * Homomorphic inner product with plaintext weights, prod(c_i^w_i) mod n^2
+   * evaluated as one multi-exponentiation
+   * @param[in] weights weights, same size as the CipherText. A negative
+   * weight is given as -|m| or n-|m|, it runs with its magnitude and the
+   * result is divided by that product.
+   * @return CipherText of size 1
+   */
+  CipherText dot(const PlainText& weights) const;
+
+  /**
+   * Plaintext matrix times this encrypted vector, row i of the result is the
+   * homomorphic inner product of matrix row i with the CipherText. Window
+   * tables of the ciphertexts are built once and shared by all rows.
+   * @param[in] mat dense matrix with getSize() columns, negative entries
+   * are given as -|m| or n-|m| like the weights of dot()
+   * @return CipherText with one element per matrix row
+   */
+  CipherText matVec(const DenseMatrix& mat) const;
+
+  /**
+   * Plaintext CSR matrix times this encrypted vector, see above
+   */
+  CipherText matVec(const CSRMatrix& mat) const;
+
+  /**
+   * Convert the elements to the Montgomery form of n^2 used by
+   * ModMulEngine::montMul. Sums of Montgomery CipherTexts then cost a single
+   * Montgomery product per element and stay in that form through chains of
+   * homomorphic operations. Other operations convert on demand, element
+   * accessors, decryption and serialization always see the normal form.
+   */
+  CipherText toMontgomery() const;
+
+  /**
+   * Convert the elements back to the normal form
+   */
+  CipherText fromMontgomery() const;
+
+  /**
+   * Whether the elements are stored in Montgomery form
+   */
+  bool isMontgomery() const { return m_mont; }
+
+  /**
+   * Element accessors of BaseText returning the normal form
+   */
+  BigNumber getElement(const std::size_t& idx) const override;
+  std::vector<uint32_t> getElementVec(const std::size_t& idx) const override;
+  std::string getElementHex(const std::size_t& idx) const override;
+  std::vector<BigNumber> getChunk(const std::size_t& start,
+                                  const std::size_t& size) const override;
+  std::vector<BigNumber> getTexts() const override;
+
+  /**
+   * Element reference of BaseText, throws in Montgomery form since the
+   * stored value is not the ciphertext
+   */
+  BigNumber& operator[](const std::size_t idx) override;
+
+  /**
+   * Insert a normal-form element before pos, converted to the Montgomery
+   * form when the CipherText is in that form
+   */
+  void insert(const std::size_t pos, BigNumber& bn) override;
+
   /**
    * Get ciphertext of idx
    */
@@ -63,12 +180,15 @@ class CipherText : public BaseText {
   CipherText rotate(int shift) const;
 
  private:
-  BigNumber raw_add(const BigNumber& a, const BigNumber& b) const;
+  void raw_add(BigNumber& out, const BigNumber& a, const BigNumber& b) const;
   BigNumber raw_mul(const BigNumber& a, const BigNumber& b) const;
   std::vector<BigNumber> raw_mul(const std::vector<BigNumber>& a,
                                  const std::vector<BigNumber>& b) const;
+  std::vector<BigNumber> fixed_base_mul(const std::vector<BigNumber>& b) const;
 
   std::shared_ptr<PublicKey> m_pk;  ///< Public key used to encrypt big number
+  std::shared_ptr<FixedBaseCache> m_fixed_base;  ///< Precomputed tables
+  bool m_mont = false;  ///< Elements are in Montgomery form
 };
 
 }  // namespace ipcl
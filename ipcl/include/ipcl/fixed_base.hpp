@@ -0,0 +1,123 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef IPCL_INCLUDE_IPCL_FIXED_BASE_HPP_
+#define IPCL_INCLUDE_IPCL_FIXED_BASE_HPP_
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "ipcl/bignum.h"
+#include "ipcl/mod_mul.hpp"
+
+namespace ipcl {
+
+/**
+ * Default comb width of CipherText::precompute
+ */
+constexpr int IPCL_FIXED_BASE_WINDOW = 8;
+
+/**
+ * Default memory bound of the fixed-base tables cached by a CipherText
+ */
+constexpr std::size_t IPCL_FIXED_BASE_CACHE_BYTES = std::size_t(256) << 20;
+
+/**
+ * Lim-Lee comb table of a fixed base. For exponents of up to getExpBits()
+ * bits split into window teeth spaced d = ceil(bits / window) apart, entry v
+ * holds prod(base^(2^(k * d))) over the set bits k of v. An exponentiation
+ * then costs d squarings and at most d multiplications, batches of them run
+ * on the lanes of ModMulEngine::combPow.
+ */
+class FixedBaseTable {
+ public:
+  /**
+   * FixedBaseTable constructor
+   * @param[in] base fixed base
+   * @param[in] exp_bits largest exponent bit length served by the table
+   * @param[in] window number of comb teeth, the table has 2^window entries
+   * @param[in] engine batched multiplication engine of the modulus
+   */
+  FixedBaseTable(const BigNumber& base, int exp_bits, int window,
+                 std::shared_ptr<const ModMulEngine> engine);
+
+  /**
+   * base^exp mod m
+   * @param[in] exp non-negative exponent of at most getExpBits() bits
+   */
+  BigNumber pow(const BigNumber& exp) const;
+
+  /**
+   * r[i] = base_i^exp[i] mod m where base_i is the base of tables[i]
+   * @param[in] tables tables built by the same engine with the same window
+   * and exponent size
+   * @param[in] exp non-negative exponents, one per table
+   */
+  static std::vector<BigNumber> pow(
+      const std::vector<const FixedBaseTable*>& tables,
+      const std::vector<BigNumber>& exp);
+
+  const BigNumber& getBase() const { return m_base; }
+  int getExpBits() const { return m_exp_bits; }
+  int getWindow() const { return m_window; }
+
+  /**
+   * Memory held by the table in bytes
+   */
+  std::size_t getBytes() const { return m_table.size() * sizeof(Ipp64u); }
+
+ private:
+  std::shared_ptr<const ModMulEngine> m_engine;
+  BigNumber m_base;
+  int m_exp_bits;
+  int m_window;
+  int m_spacing;                ///< Distance d between two comb teeth
+  std::vector<Ipp64u> m_table;  ///< 2^window entries, see combTable
+};
+
+/**
+ * Thread safe least recently used cache of fixed-base tables keyed by
+ * element index and exponent bit length, bounded by the total table size
+ */
+class FixedBaseCache {
+ public:
+  explicit FixedBaseCache(std::size_t limit = IPCL_FIXED_BASE_CACHE_BYTES);
+
+  /**
+   * Add a table for element idx, evicting the least recently used tables
+   * when the memory bound is exceeded
+   */
+  void insert(std::size_t idx, std::shared_ptr<const FixedBaseTable> table);
+
+  /**
+   * Find the smallest table of element idx serving exponents of exp_bits
+   * bits, nullptr if there is none or the element value changed since
+   */
+  std::shared_ptr<const FixedBaseTable> find(std::size_t idx,
+                                             const BigNumber& base,
+                                             int exp_bits) const;
+
+  /**
+   * Memory held by the cached tables in bytes
+   */
+  std::size_t getBytes() const;
+
+  std::size_t getLimit() const { return m_limit; }
+
+ private:
+  using Key = std::pair<std::size_t, int>;
+  using Entry = std::pair<Key, std::shared_ptr<const FixedBaseTable>>;
+
+  mutable std::mutex m_mutex;
+  mutable std::list<Entry> m_lru;  ///< Most recently used first
+  std::map<Key, std::list<Entry>::iterator> m_index;
+  std::size_t m_bytes = 0;
+  std::size_t m_limit;
+};
+
+}  // namespace ipcl
+#endif  // IPCL_INCLUDE_IPCL_FIXED_BASE_HPP_
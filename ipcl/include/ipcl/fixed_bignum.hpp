@@ -0,0 +1,456 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef IPCL_INCLUDE_IPCL_FIXED_BIGNUM_HPP_
+#define IPCL_INCLUDE_IPCL_FIXED_BIGNUM_HPP_
+
+#include <array>
+#include <type_traits>
+#include <vector>
+
+#include "ipcl/bignum.h"
+
+#define IPCL_PRAGMA(x) _Pragma(#x)
+#define IPCL_UNROLL IPCL_PRAGMA(GCC unroll 128)
+
+namespace ipcl {
+
+/**
+ * Largest operand handled by the limb kernels: n^2 of a 4096-bit key
+ */
+constexpr int IPCL_MAX_LIMBS = 128;
+
+/**
+ * Fixed-size big number kept on the stack, kBits must be a multiple of 64
+ */
+template <int kBits>
+class FixedBigNum {
+ public:
+  static_assert(kBits > 0 && kBits % 64 == 0,
+                "FixedBigNum: bit size must be a positive multiple of 64");
+  static constexpr int kLimbs = kBits / 64;
+
+  FixedBigNum() : m_limbs{} {}
+
+  Ipp64u* data() { return m_limbs.data(); }
+  const Ipp64u* data() const { return m_limbs.data(); }
+  Ipp64u& operator[](int idx) { return m_limbs[idx]; }
+  const Ipp64u& operator[](int idx) const { return m_limbs[idx]; }
+
+ private:
+  std::array<Ipp64u, kLimbs> m_limbs;
+};
+
+/**
+ * Stack storage for N limbs, N == 0 selects the runtime-sized kernels and
+ * reserves IPCL_MAX_LIMBS
+ */
+template <int N>
+using LimbArray = FixedBigNum<(N ? N : IPCL_MAX_LIMBS) * 64>;
+
+namespace limb {
+
+using u128 = unsigned __int128;
+
+/**
+ * Limb count of a kernel instance, constant folded whenever N != 0
+ */
+template <int N>
+constexpr int len(int n) {
+  return N ? N : n;
+}
+
+template <int N>
+inline void zero(Ipp64u* r, int n = N) {
+  const int l = len<N>(n);
+  IPCL_UNROLL
+  for (int i = 0; i < l; i++) r[i] = 0;
+}
+
+template <int N>
+inline void copy(Ipp64u* r, const Ipp64u* a, int n = N) {
+  const int l = len<N>(n);
+  IPCL_UNROLL
+  for (int i = 0; i < l; i++) r[i] = a[i];
+}
+
+/**
+ * r = a + b, returns the carry out
+ */
+template <int N>
+inline Ipp64u add(Ipp64u* r, const Ipp64u* a, const Ipp64u* b, int n = N) {
+  const int l = len<N>(n);
+  Ipp64u carry = 0;
+  IPCL_UNROLL
+  for (int i = 0; i < l; i++) {
+    u128 s = static_cast<u128>(a[i]) + b[i] + carry;
+    r[i] = static_cast<Ipp64u>(s);
+    carry = static_cast<Ipp64u>(s >> 64);
+  }
+  return carry;
+}
+
+/**
+ * r = a - b, returns the borrow out
+ */
+template <int N>
+inline Ipp64u sub(Ipp64u* r, const Ipp64u* a, const Ipp64u* b, int n = N) {
+  const int l = len<N>(n);
+  Ipp64u borrow = 0;
+  IPCL_UNROLL
+  for (int i = 0; i < l; i++) {
+    u128 d = static_cast<u128>(a[i]) - b[i] - borrow;
+    r[i] = static_cast<Ipp64u>(d);
+    borrow = static_cast<Ipp64u>(d >> 64) & 1;
+  }
+  return borrow;
+}
+
+/**
+ * Compare a and b, returns -1, 0 or 1
+ */
+template <int N>
+inline int cmp(const Ipp64u* a, const Ipp64u* b, int n = N) {
+  const int l = len<N>(n);
+  for (int i = l - 1; i >= 0; i--) {
+    if (a[i] != b[i]) return a[i] > b[i] ? 1 : -1;
+  }
+  return 0;
+}
+
+/**
+ * r = a * b with schoolbook multiplication, r holds 2 * N limbs
+ */
+template <int N>
+inline void mul(Ipp64u* r, const Ipp64u* a, const Ipp64u* b, int n = N) {
+  const int l = len<N>(n);
+  zero<N>(r, l);
+  for (int i = 0; i < l; i++) {
+    Ipp64u carry = 0;
+    Ipp64u ai = a[i];
+    IPCL_UNROLL
+    for (int j = 0; j < l; j++) {
+      u128 s = static_cast<u128>(ai) * b[j] + r[i + j] + carry;
+      r[i + j] = static_cast<Ipp64u>(s);
+      carry = static_cast<Ipp64u>(s >> 64);
+    }
+    r[i + l] = carry;
+  }
+}
+
+/**
+ * r = a * b mod 2^(64N), the low half of the product. r may alias a or b.
+ */
+template <int N>
+inline void mulLow(Ipp64u* r, const Ipp64u* a, const Ipp64u* b, int n = N) {
+  const int l = len<N>(n);
+  Ipp64u t[len<N>(IPCL_MAX_LIMBS)];
+  zero<N>(t, l);
+  for (int i = 0; i < l; i++) {
+    Ipp64u carry = 0;
+    Ipp64u ai = a[i];
+    for (int j = 0; i + j < l; j++) {
+      u128 s = static_cast<u128>(ai) * b[j] + t[i + j] + carry;
+      t[i + j] = static_cast<Ipp64u>(s);
+      carry = static_cast<Ipp64u>(s >> 64);
+    }
+  }
+  copy<N>(r, t, l);
+}
+
+/**
+ * Montgomery multiplication (CIOS), r = a * b * 2^(-64N) mod m.
+ * Requires a < 2^(64N), b < m and k0 = -m^(-1) mod 2^64. r may alias a or b.
+ */
+template <int N>
+inline void montMul(Ipp64u* r, const Ipp64u* a, const Ipp64u* b,
+                    const Ipp64u* m, Ipp64u k0, int n = N) {
+  const int l = len<N>(n);
+  Ipp64u t[len<N>(IPCL_MAX_LIMBS) + 2];
+  for (int j = 0; j < l + 2; j++) t[j] = 0;
+
+  for (int i = 0; i < l; i++) {
+    Ipp64u carry = 0;
+    Ipp64u bi = b[i];
+    IPCL_UNROLL
+    for (int j = 0; j < l; j++) {
+      u128 s = static_cast<u128>(a[j]) * bi + t[j] + carry;
+      t[j] = static_cast<Ipp64u>(s);
+      carry = static_cast<Ipp64u>(s >> 64);
+    }
+    u128 s = static_cast<u128>(t[l]) + carry;
+    t[l] = static_cast<Ipp64u>(s);
+    t[l + 1] = static_cast<Ipp64u>(s >> 64);
+
+    Ipp64u u = t[0] * k0;
+    s = static_cast<u128>(u) * m[0] + t[0];
+    carry = static_cast<Ipp64u>(s >> 64);
+    IPCL_UNROLL
+    for (int j = 1; j < l; j++) {
+      s = static_cast<u128>(u) * m[j] + t[j] + carry;
+      t[j - 1] = static_cast<Ipp64u>(s);
+      carry = static_cast<Ipp64u>(s >> 64);
+    }
+    s = static_cast<u128>(t[l]) + carry;
+    t[l - 1] = static_cast<Ipp64u>(s);
+    t[l] = t[l + 1] + static_cast<Ipp64u>(s >> 64);
+  }
+
+  if (t[l] || cmp<N>(t, m, l) >= 0)
+    sub<N>(r, t, m, l);
+  else
+    copy<N>(r, t, l);
+}
+
+/**
+ * Montgomery reduction of a double width value, r = x * 2^(-64N) mod m
+ * up to one multiple of m, the result is always below 2^(64N).
+ * x holds 2 * N limbs and is clobbered.
+ */
+template <int N>
+inline void montRedc(Ipp64u* r, Ipp64u* x, const Ipp64u* m, Ipp64u k0,
+                     int n = N) {
+  const int l = len<N>(n);
+  Ipp64u top = 0;
+  for (int i = 0; i < l; i++) {
+    Ipp64u u = x[i] * k0;
+    Ipp64u carry = 0;
+    IPCL_UNROLL
+    for (int j = 0; j < l; j++) {
+      u128 s = static_cast<u128>(u) * m[j] + x[i + j] + carry;
+      x[i + j] = static_cast<Ipp64u>(s);
+      carry = static_cast<Ipp64u>(s >> 64);
+    }
+    u128 s = static_cast<u128>(x[i + l]) + carry + top;
+    x[i + l] = static_cast<Ipp64u>(s);
+    top = static_cast<Ipp64u>(s >> 64);
+  }
+
+  if (top || cmp<N>(x + l, m, l) >= 0)
+    sub<N>(r, x + l, m, l);
+  else
+    copy<N>(r, x + l, l);
+}
+
+}  // namespace limb
+
+/**
+ * Calls f with std::integral_constant<int, N> where N is the compile-time
+ * limb count matching limbs, or N == 0 (runtime-sized kernels) for
+ * non-standard sizes. Covers p, q, n, p^2, q^2 and n^2 of 1024 to 4096-bit
+ * keys.
+ */
+template <typename F>
+inline decltype(auto) dispatchLimbs(int limbs, F&& f) {
+  switch (limbs) {
+    case 8:
+      return f(std::integral_constant<int, 8>{});
+    case 16:
+      return f(std::integral_constant<int, 16>{});
+    case 24:
+      return f(std::integral_constant<int, 24>{});
+    case 32:
+      return f(std::integral_constant<int, 32>{});
+    case 48:
+      return f(std::integral_constant<int, 48>{});
+    case 64:
+      return f(std::integral_constant<int, 64>{});
+    case 96:
+      return f(std::integral_constant<int, 96>{});
+    case 128:
+      return f(std::integral_constant<int, 128>{});
+    default:
+      return f(std::integral_constant<int, 0>{});
+  }
+}
+
+/**
+ * Precomputed Montgomery constants of a fixed odd modulus. The arithmetic
+ * member templates take the limb count N from dispatchLimbs(getLimbs(), ...)
+ * so standard key sizes run fully unrolled, stack allocated kernels.
+ * All members are const and the context can be shared between threads.
+ */
+class MontContext {
+ public:
+  MontContext() = default;
+  ~MontContext() = default;
+
+  /**
+   * MontContext constructor
+   * @param[in] mod odd modulus
+   */
+  explicit MontContext(const BigNumber& mod);
+
+  /**
+   * Limb count of the modulus
+   */
+  int getLimbs() const { return m_limbs; }
+
+  /**
+   * Gets the modulus
+   */
+  const BigNumber& getModulus() const { return m_mod_bn; }
+
+  const Ipp64u* mod() const { return m_mod.data(); }
+  const Ipp64u* r2() const { return m_r2.data(); }
+  const Ipp64u* one() const { return m_one.data(); }
+  Ipp64u k0() const { return m_k0; }
+
+  /**
+   * Load a BigNumber into getLimbs() limbs, reduced modulo the modulus
+   */
+  void load(Ipp64u* r, const BigNumber& bn) const;
+
+  /**
+   * Convert getLimbs() limbs to BigNumber
+   */
+  BigNumber store(const Ipp64u* a) const;
+
+  /**
+   * Convert getLimbs() limbs into an existing BigNumber, reusing its storage
+   */
+  void store(BigNumber& out, const Ipp64u* a) const;
+
+  /**
+   * r = a * b * R^(-1) mod m
+   */
+  template <int N>
+  void mul(Ipp64u* r, const Ipp64u* a, const Ipp64u* b) const {
+    limb::montMul<N>(r, a, b, mod(), m_k0, m_limbs);
+  }
+
+  /**
+   * r = a * R mod m
+   */
+  template <int N>
+  void toMont(Ipp64u* r, const Ipp64u* a) const {
+    mul<N>(r, a, r2());
+  }
+
+  /**
+   * r = a * R^(-1) mod m
+   */
+  template <int N>
+  void fromMont(Ipp64u* r, const Ipp64u* a) const {
+    LimbArray<N> unit;
+    unit[0] = 1;
+    mul<N>(r, a, unit.data());
+  }
+
+  /**
+   * r = a * b mod m for operands in normal representation
+   */
+  template <int N>
+  void modMul(Ipp64u* r, const Ipp64u* a, const Ipp64u* b) const {
+    LimbArray<N> t;
+    mul<N>(t.data(), a, b);
+    mul<N>(r, t.data(), r2());
+  }
+
+  /**
+   * r = a + b mod m
+   */
+  template <int N>
+  void modAdd(Ipp64u* r, const Ipp64u* a, const Ipp64u* b) const {
+    Ipp64u carry = limb::add<N>(r, a, b, m_limbs);
+    if (carry || limb::cmp<N>(r, mod(), m_limbs) >= 0)
+      limb::sub<N>(r, r, mod(), m_limbs);
+  }
+
+  /**
+   * r = x mod m for a double width x of 2 * getLimbs() limbs
+   */
+  template <int N>
+  void reduce(Ipp64u* r, const Ipp64u* x) const {
+    const int l = limb::len<N>(m_limbs);
+    Ipp64u t[2 * limb::len<N>(IPCL_MAX_LIMBS)];
+    IPCL_UNROLL
+    for (int i = 0; i < 2 * l; i++) t[i] = x[i];
+    limb::montRedc<N>(r, t, mod(), m_k0, m_limbs);
+    mul<N>(r, r, r2());
+  }
+
+  /**
+   * BigNumber convenience wrappers dispatching to the fixed-size kernels
+   */
+  BigNumber modMul(const BigNumber& a, const BigNumber& b) const;
+  BigNumber modAdd(const BigNumber& a, const BigNumber& b) const;
+
+ private:
+  int m_limbs = 0;
+  Ipp64u m_k0 = 0;
+  BigNumber m_mod_bn;
+  std::vector<Ipp64u> m_mod;
+  std::vector<Ipp64u> m_r2;   ///< R^2 mod m
+  std::vector<Ipp64u> m_one;  ///< R mod m
+};
+
+/**
+ * Another Montgomery representation x * R' mod m of the modulus of a
+ * MontContext with radix R. ctx.mul(x, to_ctx) moves a value of that
+ * representation into the Montgomery domain of the context and
+ * ctx.mul(y, from_ctx) moves it back, one product each. Both factors hold
+ * getLimbs() limbs.
+ */
+struct MontDomain {
+  std::vector<Ipp64u> to_ctx;    ///< R^2 / R' mod m
+  std::vector<Ipp64u> from_ctx;  ///< R' mod m
+};
+
+/**
+ * Exact division by a fixed odd divisor d (Jebelean). When d divides x and
+ * the quotient fits in getLimbs() limbs, x / d = x * d^(-1) mod 2^(64 * l),
+ * one truncated product with a precomputed inverse instead of a long
+ * division. Quotients below d, such as those of the Paillier L function for
+ * dividends below d^2, always fit.
+ */
+class ExactDivisor {
+ public:
+  ExactDivisor() = default;
+  ~ExactDivisor() = default;
+
+  /**
+   * ExactDivisor constructor
+   * @param[in] d odd divisor
+   */
+  explicit ExactDivisor(const BigNumber& d);
+
+  /**
+   * Limb count of the divisor and of the quotients
+   */
+  int getLimbs() const { return m_limbs; }
+
+  /**
+   * q = x / d, only the low getLimbs() limbs of x are read. q may alias x.
+   */
+  template <int N>
+  void divide(Ipp64u* q, const Ipp64u* x) const {
+    limb::mulLow<N>(q, x, m_inv.data(), m_limbs);
+  }
+
+  /**
+   * BigNumber convenience wrapper of divide
+   */
+  BigNumber divide(const BigNumber& x) const;
+
+ private:
+  int m_limbs = 0;
+  std::vector<Ipp64u> m_inv;  ///< d^(-1) mod 2^(64 * m_limbs)
+};
+
+/**
+ * out = a * b mod m through the fixed-size kernels of ctx. The limb scratch
+ * lives on the stack, so nothing is allocated once out has grown to
+ * 2 * ctx.getLimbs() words. out may alias a or b.
+ */
+void mulmod_into(BigNumber& out, const BigNumber& a, const BigNumber& b,
+                 const MontContext& ctx);
+
+/**
+ * out = a + b mod m through the fixed-size kernels of ctx
+ */
+void addmod_into(BigNumber& out, const BigNumber& a, const BigNumber& b,
+                 const MontContext& ctx);
+
+}  // namespace ipcl
+#endif  // IPCL_INCLUDE_IPCL_FIXED_BIGNUM_HPP_
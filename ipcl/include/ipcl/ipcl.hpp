@@ -4,8 +4,14 @@
 #ifndef IPCL_INCLUDE_IPCL_IPCL_HPP_
 #define IPCL_INCLUDE_IPCL_IPCL_HPP_
 
+#include "ipcl/cipher_accumulator.hpp"
+#include "ipcl/cipher_expr.hpp"
 #include "ipcl/mod_exp.hpp"
+#include "ipcl/mod_inv.hpp"
+#include "ipcl/mod_reduce.hpp"
+#include "ipcl/packing.hpp"
 #include "ipcl/pri_key.hpp"
+#include "ipcl/stream.hpp"
 #include "ipcl/utils/context.hpp"
 #include "ipcl/utils/serialize.hpp"
 
@@ -82,6 +82,21 @@ std::vector<BigNumber> modExp(const std::vector<BigNumber>& base,
 BigNumber modExp(const BigNumber& base, const BigNumber& exp,
                  const BigNumber& mod);
 
+/**
+ * Modular exponentiation of up to IPCL_CRYPTO_MB_SIZE fixed-width lanes,
+ * every lane with its own modulus. All operands are BITSIZE_DWORD(mod_bits)
+ * limbs wide. On multi-buffer capable CPUs the lanes run as one mbx_exp_mb8
+ * call, otherwise one after another.
+ * @param[out] out results, one per lane
+ * @param[in] base bases, below the modulus of their lane
+ * @param[in] exp exponents of at most exp_bits bits
+ * @param[in] mod odd moduli of at most mod_bits bits
+ * @param[in] lanes number of lanes in use
+ */
+void modExpLanes(Ipp64u* const* out, const Ipp64u* const* base,
+                 const Ipp64u* const* exp, int exp_bits,
+                 const Ipp64u* const* mod, int mod_bits, int lanes);
+
 /**
  * IPP modular exponentiation for multi buffer
  * @param[in] base base of the exponentiation
@@ -0,0 +1,39 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef IPCL_INCLUDE_IPCL_MOD_INV_HPP_
+#define IPCL_INCLUDE_IPCL_MOD_INV_HPP_
+
+#include <vector>
+
+#include "ipcl/bignum.h"
+#include "ipcl/fixed_bignum.hpp"
+
+namespace ipcl {
+
+/**
+ * Smallest number of elements sharing one modular inversion in a parallel
+ * batchInverse
+ */
+constexpr std::size_t IPCL_BATCH_INV_BLOCK = 64;
+
+/**
+ * Batched modular inversion r[i] = a[i]^(-1) mod m with Montgomery's
+ * simultaneous inversion. The elements are split into one block per thread,
+ * every block costs a single extended GCD and 3 * (size - 1) Montgomery
+ * products of ctx.
+ * @param[in] a non-negative elements, all invertible modulo m
+ * @param[in] ctx Montgomery context of the modulus
+ * @return the inverses, same size as a
+ */
+std::vector<BigNumber> batchInverse(const std::vector<BigNumber>& a,
+                                    const MontContext& ctx);
+
+/**
+ * Batched modular inversion modulo an odd modulus, see above
+ */
+std::vector<BigNumber> batchInverse(const std::vector<BigNumber>& a,
+                                    const BigNumber& m);
+
+}  // namespace ipcl
+#endif  // IPCL_INCLUDE_IPCL_MOD_INV_HPP_
@@ -0,0 +1,209 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef IPCL_INCLUDE_IPCL_MOD_MUL_HPP_
+#define IPCL_INCLUDE_IPCL_MOD_MUL_HPP_
+
+#include <memory>
+#include <vector>
+
+#include "ipcl/bignum.h"
+#include "ipcl/fixed_bignum.hpp"
+
+namespace ipcl {
+
+/**
+ * Batched modular multiplication by a fixed odd modulus. On CPUs with
+ * AVX-512 IFMA, 8 products are computed at once with a radix 2^52 almost
+ * Montgomery multiplication, one element per 64-bit lane. Otherwise every
+ * element goes through the fixed-size kernels of MontContext.
+ */
+class ModMulEngine {
+ public:
+  ModMulEngine() = default;
+  ~ModMulEngine() = default;
+
+  /**
+   * ModMulEngine constructor
+   * @param[in] ctx Montgomery context of the modulus
+   */
+  explicit ModMulEngine(std::shared_ptr<const MontContext> ctx);
+
+  /**
+   * Gets the Montgomery context of the modulus
+   */
+  const MontContext& getMontContext() const { return *m_ctx; }
+
+  /**
+   * r[i] = a[i] * b[i] mod m
+   * @param[out] r result, resized to a.size(), may be the same vector as a
+   * @param[in] a first operands
+   * @param[in] b second operands, a single element is used for every a[i]
+   */
+  void modMul(std::vector<BigNumber>& r, const std::vector<BigNumber>& a,
+              const std::vector<BigNumber>& b) const;
+
+  /**
+   * Returns a[i] * b[i] mod m, see modMul above
+   */
+  std::vector<BigNumber> modMul(const std::vector<BigNumber>& a,
+                                const std::vector<BigNumber>& b) const;
+
+  /**
+   * r[i] = a[i] * b[i] / R mod m, the Montgomery product for the radix R of
+   * the engine: 2^(52 * digits) on CPUs with AVX-512 IFMA, the radix of the
+   * MontContext otherwise. Operands in Montgomery form give a result in
+   * Montgomery form.
+   * @param[out] r result, resized to a.size(), may be the same vector as a
+   * @param[in] a first operands
+   * @param[in] b second operands, a single element is used for every a[i]
+   */
+  void montMul(std::vector<BigNumber>& r, const std::vector<BigNumber>& a,
+               const std::vector<BigNumber>& b) const;
+
+  /**
+   * r[i] = a[i] * R mod m, see montMul
+   */
+  void toMont(std::vector<BigNumber>& r,
+              const std::vector<BigNumber>& a) const;
+
+  /**
+   * r[i] = a[i] / R mod m, see montMul
+   */
+  void fromMont(std::vector<BigNumber>& r,
+                const std::vector<BigNumber>& a) const;
+
+  /**
+   * r[i] = a[i]^exp[i] in the Montgomery form of montMul, a[i] * R mod m
+   * gives a[i]^exp[i] * R mod m. Fixed 4-bit windows, on CPUs with AVX-512
+   * IFMA 8 exponentiations run at once.
+   * @param[out] r results, resized to a.size(), may be the same vector as a
+   * @param[in] a bases in Montgomery form
+   * @param[in] exp non-negative exponents, a single element is used for
+   * every a[i]
+   */
+  void montPow(std::vector<BigNumber>& r, const std::vector<BigNumber>& a,
+               const std::vector<BigNumber>& exp) const;
+
+  /**
+   * Conversion factors between the Montgomery form of montMul and the one
+   * of the MontContext, see MontDomain
+   */
+  const MontDomain& getMontDomain() const { return m_domain; }
+
+  /**
+   * Running products of size elements in the internal representation of the
+   * engine, every element starts at 1. See accMul.
+   */
+  std::vector<Ipp64u> accInit(std::size_t size) const;
+
+  /**
+   * acc[i] = acc[i] * x[i] / R mod m, see montMul. On AVX-512 IFMA the
+   * elements are only kept below 2m, the final reduction is left to
+   * accFinalize.
+   * @param[in,out] acc running products of accInit
+   * @param[in] x operands, one per element
+   */
+  void accMul(std::vector<Ipp64u>& acc, const std::vector<BigNumber>& x) const;
+
+  /**
+   * acc[i] = acc[i] * other[i] / R mod m, both of the same size
+   */
+  void accMerge(std::vector<Ipp64u>& acc,
+                const std::vector<Ipp64u>& other) const;
+
+  /**
+   * r[i] = acc[i] * R^shift mod m, fully reduced
+   * @param[out] r results, resized to size
+   * @param[in] acc running products of accInit
+   * @param[in] size number of elements
+   * @param[in] shift number of R^(-1) factors to undo
+   */
+  void accFinalize(std::vector<BigNumber>& r, const std::vector<Ipp64u>& acc,
+                   std::size_t size, std::size_t shift) const;
+
+  /**
+   * Product of all elements mod m with a parallel tree reduction. Every
+   * thread multiplies a contiguous block in the Montgomery domain and
+   * undoes the accumulated R^(-1) factors once at the end, the block
+   * results are then combined pairwise.
+   * @param[in] a non-empty operands
+   * @param[in] mont operands and result are in the Montgomery form of
+   * montMul
+   */
+  BigNumber product(const std::vector<BigNumber>& a, bool mont = false) const;
+
+  /**
+   * Lim-Lee comb table of a fixed base in the internal representation of the
+   * engine. Entry v is prod(base^(2^(k * spacing))) over the set bits k of v.
+   * @param[in] base fixed base
+   * @param[in] window number of comb teeth, the table has 2^window entries
+   * @param[in] spacing distance between two comb teeth in bits
+   */
+  std::vector<Ipp64u> combTable(const BigNumber& base, int window,
+                                int spacing) const;
+
+  /**
+   * r[i] = base_i^exp[i] mod m where tables[i] is the comb table of base_i.
+   * On CPUs with AVX-512 IFMA 8 exponentiations run at once, every lane
+   * gathering its own table entries.
+   * @param[out] r results, resized to exp.size()
+   * @param[in] tables tables of combTable, all built with window and spacing
+   * @param[in] exp non-negative exponents of at most window * spacing bits
+   * @param[in] window number of comb teeth
+   * @param[in] spacing distance between two comb teeth in bits
+   */
+  void combPow(std::vector<BigNumber>& r,
+               const std::vector<const Ipp64u*>& tables,
+               const std::vector<BigNumber>& exp, int window,
+               int spacing) const;
+
+ private:
+  void ifmaModMul(std::vector<BigNumber>& r, const std::vector<BigNumber>& a,
+                  const std::vector<BigNumber>& b, bool mont = false) const;
+  void montModMul(std::vector<BigNumber>& r, const std::vector<BigNumber>& a,
+                  const std::vector<BigNumber>& b, bool mont = false) const;
+  void ifmaMontPow(std::vector<BigNumber>& r, const std::vector<BigNumber>& a,
+                   const std::vector<BigNumber>& exp) const;
+  void ctxMontPow(std::vector<BigNumber>& r, const std::vector<BigNumber>& a,
+                  const std::vector<BigNumber>& exp) const;
+  BigNumber ifmaProduct(const BigNumber* a, std::size_t size) const;
+  BigNumber montProduct(const BigNumber* a, std::size_t size) const;
+  BigNumber blockProduct(const BigNumber* a, std::size_t size) const;
+  std::vector<Ipp64u> ifmaCombTable(const std::vector<Ipp64u>& mont) const;
+  void ifmaCombPow(std::vector<BigNumber>& r,
+                   const std::vector<const Ipp64u*>& tables,
+                   const std::vector<BigNumber>& exp, int window,
+                   int spacing) const;
+  void ifmaAccMul(std::vector<Ipp64u>& acc,
+                  const std::vector<BigNumber>& x) const;
+  void montAccMul(std::vector<Ipp64u>& acc,
+                  const std::vector<BigNumber>& x) const;
+  void ifmaAccMerge(std::vector<Ipp64u>& acc,
+                    const std::vector<Ipp64u>& other) const;
+  void montAccMerge(std::vector<Ipp64u>& acc,
+                    const std::vector<Ipp64u>& other) const;
+  void ifmaAccStore(std::vector<BigNumber>& r,
+                    const std::vector<Ipp64u>& acc) const;
+  void montAccStore(std::vector<BigNumber>& r,
+                    const std::vector<Ipp64u>& acc) const;
+  void montCombPow(std::vector<BigNumber>& r,
+                   const std::vector<const Ipp64u*>& tables,
+                   const std::vector<BigNumber>& exp, int window,
+                   int spacing) const;
+
+  std::shared_ptr<const MontContext> m_ctx;
+  int m_digits = 0;              ///< Number of radix 2^52 digits
+  Ipp64u m_k0 = 0;               ///< -m^(-1) mod 2^52
+  std::vector<Ipp64u> m_mod52;   ///< Modulus in radix 2^52
+  std::vector<Ipp64u> m_r2_52;   ///< 2^(104 * m_digits) mod m in radix 2^52
+  BigNumber m_r52;               ///< 2^(52 * m_digits) mod m
+  BigNumber m_mont_r;            ///< R mod m for the radix of montMul
+  BigNumber m_mont_r2;           ///< R^2 mod m for the radix of montMul
+  MontDomain m_domain;           ///< Montgomery form of montMul to ctx
+  int m_acc_lanes = 1;           ///< Elements interleaved by accInit
+  int m_acc_words = 0;           ///< Words per element of accInit
+};
+
+}  // namespace ipcl
+#endif  // IPCL_INCLUDE_IPCL_MOD_MUL_HPP_
@@ -0,0 +1,104 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef IPCL_INCLUDE_IPCL_MOD_REDUCE_HPP_
+#define IPCL_INCLUDE_IPCL_MOD_REDUCE_HPP_
+
+#include <memory>
+#include <vector>
+
+#include "ipcl/bignum.h"
+#include "ipcl/fixed_bignum.hpp"
+
+namespace ipcl {
+
+/**
+ * Reduction modulo a fixed modulus with the constants precomputed once, in
+ * place of the long division of BigNumber::operator%. Montgomery reducers
+ * run on a MontContext and need an odd modulus, Barrett reducers keep
+ * mu = floor(2^(128 * l) / m) and accept any modulus above 1. Inputs of
+ * any sign and width are reduced by the fixed-size kernels, wider inputs
+ * block by block and negative ones through their magnitude.
+ * All members are const and the reducer can be shared between threads.
+ */
+class ModReducer {
+ public:
+  enum class Method { Barrett, Montgomery };
+
+  ModReducer() = default;
+  ~ModReducer() = default;
+
+  /**
+   * ModReducer constructor
+   * @param[in] mod modulus, odd for Method::Montgomery
+   * @param[in] method reduction algorithm
+   */
+  ModReducer(const BigNumber& mod, Method method);
+
+  /**
+   * Montgomery reducer sharing an existing context
+   */
+  explicit ModReducer(std::shared_ptr<const MontContext> ctx);
+
+  Method getMethod() const { return m_method; }
+  const BigNumber& getModulus() const { return m_mod_bn; }
+
+  /**
+   * Limb count of the modulus
+   */
+  int getLimbs() const { return m_limbs; }
+
+  /**
+   * r[i] = a[i] mod m, r may alias a
+   */
+  void reduce(std::vector<BigNumber>& r,
+              const std::vector<BigNumber>& a) const;
+
+  /**
+   * r[i] = a[i] * b[i] mod m, b of size 1 is broadcast. r may alias a or b.
+   */
+  void mulmod(std::vector<BigNumber>& r, const std::vector<BigNumber>& a,
+              const std::vector<BigNumber>& b) const;
+
+  /**
+   * r[i] = a[i] + b[i] mod m, b of size 1 is broadcast. r may alias a or b.
+   */
+  void addmod(std::vector<BigNumber>& r, const std::vector<BigNumber>& a,
+              const std::vector<BigNumber>& b) const;
+
+  /**
+   * Load a BigNumber into getLimbs() limbs, reduced modulo the modulus
+   */
+  void load(Ipp64u* r, const BigNumber& a) const;
+
+  /**
+   * Single element versions of the above
+   */
+  BigNumber reduce(const BigNumber& a) const;
+  BigNumber mulmod(const BigNumber& a, const BigNumber& b) const;
+  BigNumber addmod(const BigNumber& a, const BigNumber& b) const;
+
+ private:
+  // Element kernels, out may alias a or b
+  void reduceOne(BigNumber& out, const BigNumber& a) const;
+  void mulmodOne(BigNumber& out, const BigNumber& a, const BigNumber& b) const;
+  void addmodOne(BigNumber& out, const BigNumber& a, const BigNumber& b) const;
+
+  // Load a reduced operand into getLimbs() limbs
+  template <int N>
+  void loadLimbs(Ipp64u* r, const BigNumber& a) const;
+
+  // r = x mod m for a double width x of 2 * getLimbs() limbs
+  template <int N>
+  void reduceWide(Ipp64u* r, const Ipp64u* x) const;
+
+  Method m_method = Method::Barrett;
+  int m_limbs = 0;
+  BigNumber m_mod_bn;
+  std::vector<Ipp64u> m_mod;
+  std::vector<Ipp64u> m_mu;  ///< Barrett only, getLimbs() + 1 limbs
+  std::shared_ptr<const MontContext> m_mont;  ///< Montgomery only
+};
+
+}  // namespace ipcl
+#endif  // IPCL_INCLUDE_IPCL_MOD_REDUCE_HPP_
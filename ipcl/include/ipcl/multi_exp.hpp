@@ -0,0 +1,71 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef IPCL_INCLUDE_IPCL_MULTI_EXP_HPP_
+#define IPCL_INCLUDE_IPCL_MULTI_EXP_HPP_
+
+#include <vector>
+
+#include "ipcl/bignum.h"
+#include "ipcl/fixed_bignum.hpp"
+#include "ipcl/plain_matrix.hpp"
+
+namespace ipcl {
+
+/**
+ * Below this many bases a block uses Straus' interleaved windows, above it
+ * the Pippenger bucket method
+ */
+constexpr std::size_t IPCL_MULTI_EXP_STRAUS_THRESHOLD = 32;
+
+/**
+ * Simultaneous multi-exponentiation prod(base[i]^exp[i]) mod m.
+ * The bases are split into one block per thread, every block is evaluated in
+ * the Montgomery domain of ctx with Straus' method for few bases or
+ * Pippenger's bucket method for many, and the block results are multiplied.
+ * @param[in] base bases
+ * @param[in] exp non-negative exponents, same size as base
+ * @param[in] ctx Montgomery context of the modulus
+ * @param[in] dom representation of the bases and the result, normal form
+ * when nullptr
+ * @return the product of the exponentiations
+ */
+BigNumber multiExp(const std::vector<BigNumber>& base,
+                   const std::vector<BigNumber>& exp, const MontContext& ctx,
+                   const MontDomain* dom = nullptr);
+
+/**
+ * Rows of a matrix-vector product evaluated per row block
+ */
+constexpr std::size_t IPCL_MATVEC_ROW_BLOCK = 16;
+
+/**
+ * Upper bound of the shared window tables of a matrix-vector product
+ */
+constexpr std::size_t IPCL_MATVEC_TABLE_BYTES = std::size_t(64) << 20;
+
+/**
+ * Matrix-vector multi-exponentiation r[i] = prod_j(base[j]^mat[i][j]) mod m.
+ * A table of 2^w powers is built once per base and shared by all rows, the
+ * window w balances the table cost against the number of rows. Rows are
+ * processed in blocks of IPCL_MATVEC_ROW_BLOCK, in parallel across blocks.
+ * @param[in] base bases, one per matrix column
+ * @param[in] mat dense matrix of non-negative exponents
+ * @param[in] ctx Montgomery context of the modulus
+ * @param[in] dom representation of the bases and the results, normal form
+ * when nullptr
+ * @return one result per matrix row
+ */
+std::vector<BigNumber> matVecExp(const std::vector<BigNumber>& base,
+                                 const DenseMatrix& mat, const MontContext& ctx,
+                                 const MontDomain* dom = nullptr);
+
+/**
+ * Matrix-vector multi-exponentiation with a CSR matrix, see above
+ */
+std::vector<BigNumber> matVecExp(const std::vector<BigNumber>& base,
+                                 const CSRMatrix& mat, const MontContext& ctx,
+                                 const MontDomain* dom = nullptr);
+
+}  // namespace ipcl
+#endif  // IPCL_INCLUDE_IPCL_MULTI_EXP_HPP_
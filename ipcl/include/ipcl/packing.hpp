@@ -0,0 +1,159 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef IPCL_INCLUDE_IPCL_PACKING_HPP_
+#define IPCL_INCLUDE_IPCL_PACKING_HPP_
+
+#include <vector>
+
+#include "ipcl/ciphertext.hpp"
+#include "ipcl/plaintext.hpp"
+#include "ipcl/pri_key.hpp"
+
+namespace ipcl {
+
+/**
+ * Default number of overflow bits above the value bits of a slot
+ */
+constexpr int IPCL_SLOT_HEADROOM_BITS = 16;
+
+/**
+ * Layout of many small non-negative integers in one plaintext. Slot i of a
+ * packed element occupies bits [i * w, (i + 1) * w) with w = slot_bits +
+ * headroom_bits, so homomorphic sums and scalar products of packed
+ * plaintexts act slot-wise as long as no slot exceeds 2^w - 1. The slots of
+ * one element fill at most bit length of n - 1 bits and stay below n.
+ */
+class SlotPacker {
+ public:
+  SlotPacker() = default;
+  ~SlotPacker() = default;
+
+  /**
+   * SlotPacker constructor
+   * @param[in] pk public key the packed plaintexts are encrypted under
+   * @param[in] slot_bits bit length of the packed values
+   * @param[in] headroom_bits overflow bits reserved above each value
+   */
+  SlotPacker(const PublicKey& pk, int slot_bits,
+             int headroom_bits = IPCL_SLOT_HEADROOM_BITS);
+
+  /**
+   * Number of slots per plaintext element
+   */
+  std::size_t getSlotCount() const { return m_slots; }
+
+  int getSlotBits() const { return m_slot_bits; }
+  int getHeadroomBits() const { return m_headroom_bits; }
+
+  /**
+   * Bit width of a slot, value and headroom bits together
+   */
+  int getSlotWidth() const { return m_slot_bits + m_headroom_bits; }
+
+  /**
+   * Number of plaintext elements holding count values
+   */
+  std::size_t getPackedSize(std::size_t count) const {
+    return (count + m_slots - 1) / m_slots;
+  }
+
+  /**
+   * Pack values below 2^getSlotBits() into getPackedSize(values.size())
+   * elements, the unused slots of the last element are zero
+   */
+  PlainText pack(const std::vector<BigNumber>& values) const;
+  PlainText pack(const std::vector<uint32_t>& values) const;
+
+  /**
+   * Split the first count slots of a packed, possibly decrypted, PlainText
+   */
+  std::vector<BigNumber> unpack(const PlainText& pt, std::size_t count) const;
+
+  bool operator==(const SlotPacker& other) const {
+    return m_slots == other.m_slots && m_slot_bits == other.m_slot_bits &&
+           m_headroom_bits == other.m_headroom_bits;
+  }
+
+ private:
+  std::size_t m_slots = 0;
+  int m_slot_bits = 0;
+  int m_headroom_bits = 0;
+};
+
+/**
+ * CipherText of packed slots together with an upper bound on every slot
+ * value. Slot-wise operations update the bound and throw before a slot
+ * could carry into its neighbour.
+ */
+class PackedCipherText {
+ public:
+  PackedCipherText() = default;
+  ~PackedCipherText() = default;
+
+  /**
+   * Encrypt values with pk.encrypt, the bound is 2^slot_bits - 1
+   */
+  PackedCipherText(const PublicKey& pk, const SlotPacker& packer,
+                   const std::vector<BigNumber>& values);
+
+  /**
+   * Wrap a CipherText of count packed values, each at most bound
+   */
+  PackedCipherText(const SlotPacker& packer, const CipherText& ct,
+                   std::size_t count, const BigNumber& bound);
+
+  /**
+   * Compact a CipherText of values in [0, bound] into
+   * packer.getPackedSize(ct.getSize()) elements. Element j is
+   * prod(ct[j * k + i]^(2^(w * i))) mod n^2 with k slots of width w, so its
+   * decryption carries ct[j * k + i] in slot i. The shifts run as one chain
+   * of shared squarings, (k - 1) * w squarings and k - 1 products per
+   * element, and decrypt() recovers all values from a single decryption.
+   */
+  static PackedCipherText compact(const SlotPacker& packer,
+                                  const CipherText& ct,
+                                  const BigNumber& bound);
+
+  /**
+   * Slot-wise sum of two packed CipherTexts with the same layout and count
+   */
+  PackedCipherText operator+(const PackedCipherText& other) const;
+
+  /**
+   * Multiply every slot by the same non-negative scalar
+   */
+  PackedCipherText operator*(const BigNumber& scalar) const;
+
+  /**
+   * Decrypt with sk.decrypt and unpack the getCount() slot values
+   */
+  std::vector<BigNumber> decrypt(const PrivateKey& sk) const;
+
+  const CipherText& getCipherText() const { return m_ct; }
+  const SlotPacker& getPacker() const { return m_packer; }
+
+  /**
+   * Number of packed values
+   */
+  std::size_t getCount() const { return m_count; }
+
+  /**
+   * Upper bound on every slot value
+   */
+  const BigNumber& getBound() const { return m_bound; }
+
+  /**
+   * Number of slot doublings left before the bound could overflow a slot
+   */
+  int getHeadroom() const;
+
+ private:
+  SlotPacker m_packer;
+  CipherText m_ct;
+  std::size_t m_count = 0;
+  BigNumber m_bound;
+};
+
+}  // namespace ipcl
+#endif  // IPCL_INCLUDE_IPCL_PACKING_HPP_
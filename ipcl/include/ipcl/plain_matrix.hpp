@@ -0,0 +1,35 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef IPCL_INCLUDE_IPCL_PLAIN_MATRIX_HPP_
+#define IPCL_INCLUDE_IPCL_PLAIN_MATRIX_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include "ipcl/bignum.h"
+
+namespace ipcl {
+
+/**
+ * Dense plaintext matrix stored row by row
+ */
+struct DenseMatrix {
+  std::size_t rows = 0;
+  std::size_t cols = 0;
+  std::vector<BigNumber> values;  ///< rows * cols entries, row-major
+};
+
+/**
+ * Sparse plaintext matrix in compressed sparse row (CSR) format
+ */
+struct CSRMatrix {
+  std::size_t rows = 0;
+  std::size_t cols = 0;
+  std::vector<std::size_t> row_ptr;  ///< rows + 1 offsets into col_idx
+  std::vector<std::size_t> col_idx;  ///< Column of each stored entry
+  std::vector<BigNumber> values;     ///< Stored entries
+};
+
+}  // namespace ipcl
+#endif  // IPCL_INCLUDE_IPCL_PLAIN_MATRIX_HPP_
@@ -10,9 +10,16 @@
 
 #include "ipcl/ciphertext.hpp"
 #include "ipcl/plaintext.hpp"
+#include "ipcl/stream.hpp"
 
 namespace ipcl {
 
+/**
+ * Ciphertexts per chunk of CRT decryption, their p and q halves fill the
+ * IPCL_CRYPTO_MB_SIZE lanes of one multi-buffer exponentiation
+ */
+constexpr std::size_t IPCL_CRT_CHUNK_SIZE = IPCL_CRYPTO_MB_SIZE / 2;
+
 class PrivateKey {
  public:
   PrivateKey() = default;
@@ -49,6 +56,51 @@ class PrivateKey {
 
   void decrypt2(const CipherText& ciphertext, void** destination) const;
 
+  /**
+   * Decrypt plaintexts known to fit in 64 bits straight into native
+   * integers. The CRT recombination finishes on the residues modulo p and
+   * q, no BigNumber plaintext is built.
+   * @param[in] ciphertext CipherText to be decrypted
+   * @param[out] out buffer of ciphertext.getSize() elements
+   * @param[in] size number of elements of out
+   * @throws std::runtime_error if a plaintext does not fit
+   */
+  void decrypt_to(const CipherText& ciphertext, uint64_t* out,
+                  std::size_t size) const;
+
+  /**
+   * Decrypt into signed native integers, see above. Negative values are
+   * decoded from their n - |m| encoding.
+   */
+  void decrypt_to(const CipherText& ciphertext, int64_t* out,
+                  std::size_t size) const;
+
+  /**
+   * Encrypt as the owner of the private key. The obfuscator r^n or hs^r mod
+   * n^2 is computed modulo p^2 and q^2 with exponents reduced modulo
+   * phi(p^2) and phi(q^2), as one mixed-modulus multi-buffer exponentiation
+   * per IPCL_CRT_CHUNK_SIZE plaintexts, and recombined by CRT. With the same
+   * random values the ciphertexts equal those of pk.encrypt.
+   * @param[in] pk public key of this private key, provides the obfuscator
+   * kind and the random values
+   * @param[in] plaintext PlainText to be encrypted
+   * @param[in] make_secure apply obfuscator(default value is true)
+   * @return ciphertext of type CipherText
+   */
+  CipherText encrypt(const PublicKey& pk, const PlainText& plaintext,
+                     bool make_secure = true) const;
+
+  /**
+   * Streaming decryption with bounded memory. Chunks of up to chunk_size
+   * ciphertexts of this key are pulled from source, decrypted on concurrent
+   * workers and pushed to sink in stream order, see runPipeline.
+   * @param[in] source ciphertexts, e.g. textSource(ct) or rangeSource
+   * @param[in] sink plaintexts, e.g. vectorSink
+   * @param[in] chunk_size elements per chunk
+   */
+  void decryptStream(const BigNumberSource& source, const BigNumberSink& sink,
+                     std::size_t chunk_size = IPCL_STREAM_CHUNK_SIZE) const;
+
   const void* addr = static_cast<const void*>(this);
 
   /**
@@ -97,6 +149,25 @@ class PrivateKey {
   BigNumber m_hq;
   BigNumber m_lambda;
   BigNumber m_x;
+  BigNumber m_n_phip;       ///< n mod phi(p^2)
+  BigNumber m_n_phiq;       ///< n mod phi(q^2)
+  BigNumber m_psqinverse;   ///< (p^2)^(-1) mod q^2
+
+  // Montgomery contexts of the CRT moduli, shared by copies of the key
+  std::shared_ptr<MontContext> m_p_mont;
+  std::shared_ptr<MontContext> m_q_mont;
+  std::shared_ptr<MontContext> m_psq_mont;
+  std::shared_ptr<MontContext> m_qsq_mont;
+  std::shared_ptr<MontContext> m_n_mont;
+
+  // Barrett reducers of the squared CRT moduli
+  std::shared_ptr<ModReducer> m_psq_reducer;
+  std::shared_ptr<ModReducer> m_qsq_reducer;
+
+  // Exact divisors of the L function
+  std::shared_ptr<ExactDivisor> m_p_div;
+  std::shared_ptr<ExactDivisor> m_q_div;
+  std::shared_ptr<ExactDivisor> m_n_div;
 
   /**
    * Compute L function in paillier scheme
@@ -114,14 +185,6 @@ class PrivateKey {
    */
   BigNumber computeHfun(const BigNumber& a, const BigNumber& b) const;
 
-  /**
-   * Compute CRT function in paillier scheme
-   * @param[in] mp input mp
-   * @param[in] mq input mq
-   * @return the CRT result of type BigNumber
-   */
-  BigNumber computeCRT(const BigNumber& mp, const BigNumber& mq) const;
-
   /**
    * Raw decryption function without CRT optimization
    * @param[out] plaintext output plaintext
@@ -137,6 +200,38 @@ class PrivateKey {
    */
   void decryptCRT(std::vector<BigNumber>& plaintext,
                   const std::vector<BigNumber>& ciphertext) const;
+
+  /**
+   * CRT decryption of up to IPCL_CRT_CHUNK_SIZE ciphertexts, from the
+   * reductions modulo p^2 and q^2 through one mixed-modulus multi-buffer
+   * exponentiation to the CRT coefficients, in one set of lane buffers.
+   * Plaintext i is mp[i] + u[i] * p with mp[i] < p and u[i] < q.
+   * @param[out] mp k plaintexts modulo p
+   * @param[out] u k recombination coefficients
+   * @param[in] ciphertext k input ciphertexts
+   * @param[in] k number of ciphertexts
+   */
+  void decryptCRTChunk(BigNumber* mp, BigNumber* u,
+                       const BigNumber* ciphertext, int k) const;
+
+  /**
+   * CRT obfuscators of up to IPCL_CRT_CHUNK_SIZE elements, r[i]^n mod n^2
+   * or, when hs is given, hs^r[i] mod n^2
+   * @param[out] obf k obfuscators
+   * @param[in] r k random values of PublicKey::getObfuscatorRandom
+   * @param[in] k number of obfuscators
+   * @param[in] hs DJN base modulo p^2 and q^2, nullptr for the normal
+   * obfuscator
+   */
+  void obfuscatorCRTChunk(BigNumber* obf, const BigNumber* r, int k,
+                          const BigNumber* hs) const;
+
+  /**
+   * Shared implementation of decrypt_to
+   */
+  template <typename T>
+  void decryptTo(const CipherText& ciphertext, T* out,
+                 std::size_t size) const;
 };
 
 }  // namespace ipcl
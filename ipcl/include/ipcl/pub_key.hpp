@@ -9,7 +9,11 @@
 #include <vector>
 
 #include "ipcl/bignum.h"
+#include "ipcl/fixed_bignum.hpp"
+#include "ipcl/mod_mul.hpp"
+#include "ipcl/mod_reduce.hpp"
 #include "ipcl/plaintext.hpp"
+#include "ipcl/stream.hpp"
 
 namespace ipcl {
 
@@ -61,6 +65,21 @@ class PublicKey {
 
   void encrypt2(const PlainText& plaintext, void** destination, bool make_secure = true) const;
 
+  /**
+   * Streaming encryption with bounded memory. Chunks of up to chunk_size
+   * plaintexts are pulled from source, encrypted on concurrent workers and
+   * pushed to sink in stream order, see runPipeline. The raw encryption,
+   * obfuscator generation and final product of different chunks overlap.
+   * Fixed test randomness of setRandom is not supported with make_secure.
+   * @param[in] source plaintexts, e.g. textSource(pt) or istreamSource
+   * @param[in] sink ciphertexts, e.g. vectorSink or ostreamSink
+   * @param[in] make_secure apply obfuscator(default value is true)
+   * @param[in] chunk_size elements per chunk
+   */
+  void encryptStream(const BigNumberSource& source, const BigNumberSink& sink,
+                     bool make_secure = true,
+                     std::size_t chunk_size = IPCL_STREAM_CHUNK_SIZE) const;
+
   /**
   Saves the PublicKey to a given location. The output file is in json
   format and human-readable.
@@ -83,6 +102,28 @@ class PublicKey {
    */
   std::shared_ptr<BigNumber> getNSQ() const { return m_nsquare; }
 
+  /**
+   * Get Montgomery context of N, shared by all copies of the key
+   */
+  std::shared_ptr<MontContext> getNMont() const { return m_n_mont; }
+
+  /**
+   * Get Montgomery context of NSQ, shared by all copies of the key
+   */
+  std::shared_ptr<MontContext> getNSQMont() const { return m_nsq_mont; }
+
+  /**
+   * Get Barrett reducer of N, shared by all copies of the key
+   */
+  std::shared_ptr<ModReducer> getNReducer() const { return m_n_reducer; }
+
+  /**
+   * Get batched modular multiplication engine of NSQ
+   */
+  std::shared_ptr<ModMulEngine> getNSQMulEngine() const {
+    return m_nsq_engine;
+  }
+
   /**
    * Get G of public key in paillier scheme
    */
@@ -98,6 +139,23 @@ class PublicKey {
    */
   int getDwords() const { return m_dwords; }
 
+  /**
+   * Raw encryption g^m = 1 + (m mod n) * n without obfuscation, written
+   * straight into r in parallel. Since (m mod n) * n + 1 < n^2 there is no
+   * reduction modulo n^2, m itself is only reduced when it is negative or
+   * not below n.
+   * @param[out] r one ciphertext per plaintext
+   * @param[in] pt plaintexts
+   */
+  void powG(std::vector<BigNumber>& r, const std::vector<BigNumber>& pt) const;
+
+  /**
+   * Draw the random values of sz obfuscators, the bases r in [1, n) of the
+   * normal obfuscator r^n or the randbits-bit exponents of the DJN
+   * obfuscator hs^r mod n^2. Values set by setRandom are returned instead.
+   */
+  std::vector<BigNumber> getObfuscatorRandom(std::size_t sz) const;
+
   /**
    * Apply obfuscator for ciphertext
    * @param[out] obfuscator output of obfuscator with random value
@@ -175,6 +233,11 @@ class PublicKey {
   std::shared_ptr<BigNumber> m_n;
   std::shared_ptr<BigNumber> m_g;
   std::shared_ptr<BigNumber> m_nsquare;
+  std::shared_ptr<MontContext> m_n_mont;
+  std::shared_ptr<MontContext> m_nsq_mont;
+  std::shared_ptr<ModMulEngine> m_nsq_engine;
+  std::shared_ptr<ModReducer> m_n_reducer;
+  std::shared_ptr<ModReducer> m_nm1_reducer;  ///< N - 1 is even
   int m_bits;
   int m_dwords;
   BigNumber m_hs;
@@ -0,0 +1,112 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef IPCL_INCLUDE_IPCL_STREAM_HPP_
+#define IPCL_INCLUDE_IPCL_STREAM_HPP_
+
+#include <algorithm>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include "ipcl/bignum.h"
+
+namespace ipcl {
+
+/**
+ * Default number of elements per chunk of the streaming operations
+ */
+constexpr std::size_t IPCL_STREAM_CHUNK_SIZE = 256;
+
+/**
+ * Source of a stream. Appends between 1 and max elements to an empty chunk
+ * and returns true, or returns false once the stream is exhausted. Calls
+ * are serialized.
+ */
+using BigNumberSource =
+    std::function<bool(std::vector<BigNumber>& chunk, std::size_t max)>;
+
+/**
+ * Sink of a stream. Receives the result chunks in stream order together
+ * with the stream index of their first element. Calls are serialized, the
+ * chunk may be moved from.
+ */
+using BigNumberSink =
+    std::function<void(std::size_t offset, std::vector<BigNumber>& chunk)>;
+
+/**
+ * Chunk transformation of a pipeline, out receives one result per element
+ * of in
+ */
+using BigNumberStage = std::function<void(std::vector<BigNumber>& out,
+                                          const std::vector<BigNumber>& in)>;
+
+/**
+ * Pull chunks of up to chunk_size elements from source, transform them by
+ * stage on up to workers chunks concurrently and push the results to sink
+ * in stream order. Every worker holds one input and one output chunk, so
+ * memory is bounded by chunk_size * workers independently of the stream
+ * length. The first exception thrown by source, stage or sink stops the
+ * pipeline and is rethrown.
+ * @param[in] workers number of concurrent chunks, OMPUtilities::MaxThreads
+ * when 0
+ */
+void runPipeline(const BigNumberSource& source, const BigNumberStage& stage,
+                 const BigNumberSink& sink, std::size_t chunk_size,
+                 int workers = 0);
+
+/**
+ * Source reading the iterator range [first, last) of BigNumber, the range
+ * must outlive the stream
+ */
+template <typename It>
+BigNumberSource rangeSource(It first, It last) {
+  return [first, last](std::vector<BigNumber>& chunk,
+                       std::size_t max) mutable {
+    for (; first != last && chunk.size() < max; ++first)
+      chunk.push_back(*first);
+    return !chunk.empty();
+  };
+}
+
+/**
+ * Source reading the elements of a PlainText or CipherText chunk by chunk,
+ * in normal form. The text must outlive the stream.
+ */
+template <typename Text>
+BigNumberSource textSource(const Text& text) {
+  std::size_t pos = 0;
+  return [&text, pos](std::vector<BigNumber>& chunk,
+                      std::size_t max) mutable {
+    std::size_t size = std::min(max, text.getSize() - pos);
+    if (size == 0) return false;
+    chunk = text.getChunk(pos, size);
+    pos += size;
+    return true;
+  };
+}
+
+/**
+ * Sink storing the stream into out, which grows as chunks arrive
+ */
+inline BigNumberSink vectorSink(std::vector<BigNumber>& out) {
+  return [&out](std::size_t offset, std::vector<BigNumber>& chunk) {
+    if (out.size() < offset + chunk.size()) out.resize(offset + chunk.size());
+    std::move(chunk.begin(), chunk.end(), out.begin() + offset);
+  };
+}
+
+/**
+ * Source reading whitespace separated hexadecimal numbers, as written by
+ * ostreamSink, until the end of is
+ */
+BigNumberSource istreamSource(std::istream& is);
+
+/**
+ * Sink writing one hexadecimal number per line to os
+ */
+BigNumberSink ostreamSink(std::ostream& os);
+
+}  // namespace ipcl
+#endif  // IPCL_INCLUDE_IPCL_STREAM_HPP_
@@ -529,6 +529,84 @@ static std::vector<BigNumber> ippSBModExpWrapper(
   return res;
 }
 
+#if defined(IPCL_RUNTIME_DETECT_CPU_FEATURES) || defined(IPCL_CRYPTO_MB_MOD_EXP)
+// Lanes of modExpLanes as one multi buffer call, unused lanes repeat the
+// last lane in use
+static void ippMBModExpLanes(Ipp64u* const* out, const Ipp64u* const* base,
+                             const Ipp64u* const* exp, int exp_bits,
+                             const Ipp64u* const* mod, int mod_bits,
+                             int lanes) {
+  std::vector<int64u*> out_pa(IPCL_CRYPTO_MB_SIZE);
+  std::vector<const int64u*> base_pa(IPCL_CRYPTO_MB_SIZE);
+  std::vector<const int64u*> exp_pa(IPCL_CRYPTO_MB_SIZE);
+  std::vector<const int64u*> mod_pa(IPCL_CRYPTO_MB_SIZE);
+
+  // Padding lanes compute into a scratch copy so that out stays untouched
+  int dwords = BITSIZE_DWORD(mod_bits);
+  std::vector<int64u> pad(dwords);
+  for (int i = 0; i < IPCL_CRYPTO_MB_SIZE; i++) {
+    int idx = std::min(i, lanes - 1);
+    out_pa[i] = i < lanes ? out[i] : pad.data();
+    base_pa[i] = base[idx];
+    exp_pa[i] = exp[idx];
+    mod_pa[i] = mod[idx];
+  }
+
+  int work_buff_size = mbx_exp_BufferSize(mod_bits);
+  auto work_buff = std::vector<Ipp8u>(work_buff_size);
+  mbx_status st =
+      mbx_exp_mb8(out_pa.data(), base_pa.data(), exp_pa.data(), exp_bits,
+                  mod_pa.data(), mod_bits, work_buff.data(), work_buff_size);
+
+  for (int i = 0; i < lanes; i++) {
+    ERROR_CHECK(MBX_STATUS_OK == MBX_GET_STS(st, i),
+                std::string("ippMBModExpLanes: error multi buffered exp "
+                            "modules, error code = ") +
+                    std::to_string(MBX_GET_STS(st, i)));
+  }
+}
+#endif  // IPCL_RUNTIME_DETECT_CPU_FEATURES || IPCL_CRYPTO_MB_MOD_EXP
+
+#if defined(IPCL_RUNTIME_DETECT_CPU_FEATURES) || \
+    !defined(IPCL_CRYPTO_MB_MOD_EXP)
+static void ippSBModExpLanes(Ipp64u* const* out, const Ipp64u* const* base,
+                             const Ipp64u* const* exp, int,
+                             const Ipp64u* const* mod, int mod_bits,
+                             int lanes) {
+  int words = BITSIZE_DWORD(mod_bits) * 2;
+  for (int i = 0; i < lanes; i++) {
+    BigNumber r = ippSBModExp(
+        BigNumber(reinterpret_cast<const Ipp32u*>(base[i]), words),
+        BigNumber(reinterpret_cast<const Ipp32u*>(exp[i]), words),
+        BigNumber(reinterpret_cast<const Ipp32u*>(mod[i]), words));
+
+    int bits;
+    Ipp32u* data;
+    ippsRef_BN(nullptr, &bits, &data, BN(r));
+    std::memset(out[i], 0, words * sizeof(Ipp32u));
+    std::memcpy(out[i], data, BITSIZE_WORD(bits) * sizeof(Ipp32u));
+  }
+}
+#endif  // IPCL_RUNTIME_DETECT_CPU_FEATURES || !IPCL_CRYPTO_MB_MOD_EXP
+
+void modExpLanes(Ipp64u* const* out, const Ipp64u* const* base,
+                 const Ipp64u* const* exp, int exp_bits,
+                 const Ipp64u* const* mod, int mod_bits, int lanes) {
+  ERROR_CHECK(lanes > 0 && lanes <= IPCL_CRYPTO_MB_SIZE,
+              "modExpLanes: invalid number of lanes");
+
+#ifdef IPCL_RUNTIME_DETECT_CPU_FEATURES
+  if (has_avx512ifma)
+    ippMBModExpLanes(out, base, exp, exp_bits, mod, mod_bits, lanes);
+  else
+    ippSBModExpLanes(out, base, exp, exp_bits, mod, mod_bits, lanes);
+#elif IPCL_CRYPTO_MB_MOD_EXP
+  ippMBModExpLanes(out, base, exp, exp_bits, mod, mod_bits, lanes);
+#else
+  ippSBModExpLanes(out, base, exp, exp_bits, mod, mod_bits, lanes);
+#endif  // IPCL_RUNTIME_DETECT_CPU_FEATURES
+}
+
 std::vector<BigNumber> ippModExp(const std::vector<BigNumber>& base,
                                  const std::vector<BigNumber>& exp,
                                  const std::vector<BigNumber>& mod) {
@@ -0,0 +1,100 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ipcl/mod_inv.hpp"
+
+#include <algorithm>
+
+#include "ipcl/utils/util.hpp"
+
+namespace ipcl {
+
+namespace {
+
+// Invert k elements in place, prefix receives the running Montgomery
+// products P_i = x_0 ... x_i * R^(-i). The plain inverse of P_(k-1) already
+// carries the R^(k-1) the backward pass removes again, so no element is ever
+// converted to or from the Montgomery form. False if an element is not
+// invertible.
+template <int N>
+bool invertBlock(const MontContext& ctx, Ipp64u* x, Ipp64u* prefix,
+                 std::size_t k) {
+  const int l = ctx.getLimbs();
+
+  limb::copy<N>(prefix, x, l);
+  for (std::size_t i = 1; i < k; i++)
+    ctx.mul<N>(prefix + i * l, prefix + (i - 1) * l, x + i * l);
+
+  // The only inversion of the block
+  BigNumber all = ctx.store(prefix + (k - 1) * l);
+  BigNumber all_inv = ctx.getModulus().InverseMul(all);
+  if (all == BigNumber::Zero() ||
+      ctx.modMul(all, all_inv) != BigNumber::One())
+    return false;
+
+  // inv holds P_i^(-1), peel off one element per step
+  LimbArray<N> inv, t;
+  ctx.load(inv.data(), all_inv);
+  for (std::size_t i = k - 1; i > 0; i--) {
+    ctx.mul<N>(t.data(), inv.data(), prefix + (i - 1) * l);
+    ctx.mul<N>(inv.data(), inv.data(), x + i * l);
+    limb::copy<N>(x + i * l, t.data(), l);
+  }
+  limb::copy<N>(x, inv.data(), l);
+  return true;
+}
+
+}  // namespace
+
+std::vector<BigNumber> batchInverse(const std::vector<BigNumber>& a,
+                                    const MontContext& ctx) {
+  const std::size_t v_size = a.size();
+  std::vector<BigNumber> res(v_size);
+  if (v_size == 0) return res;
+
+  // One block per thread, every block pays one extended GCD
+  const int l = ctx.getLimbs();
+  std::size_t blocks = 1;
+#ifdef IPCL_USE_OMP
+  blocks = std::max<std::size_t>(
+      1, std::min<std::size_t>(OMPUtilities::MaxThreads,
+                               v_size / IPCL_BATCH_INV_BLOCK));
+#endif  // IPCL_USE_OMP
+  std::size_t block_size = (v_size + blocks - 1) / blocks;
+  blocks = (v_size + block_size - 1) / block_size;
+
+  std::vector<char> invertible(blocks, 1);
+#ifdef IPCL_USE_OMP
+  int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, blocks))
+#endif  // IPCL_USE_OMP
+  for (std::size_t b = 0; b < blocks; b++) {
+    std::size_t begin = b * block_size;
+    std::size_t k = std::min(block_size, v_size - begin);
+    dispatchLimbs(l, [&](auto L) {
+      constexpr int N = decltype(L)::value;
+      std::vector<Ipp64u> x(k * l), prefix(k * l);
+      for (std::size_t i = 0; i < k; i++)
+        ctx.load(x.data() + i * l, a[begin + i]);
+
+      invertible[b] = invertBlock<N>(ctx, x.data(), prefix.data(), k);
+      if (!invertible[b]) return;
+
+      for (std::size_t i = 0; i < k; i++)
+        ctx.store(res[begin + i], x.data() + i * l);
+    });
+  }
+
+  ERROR_CHECK(std::all_of(invertible.begin(), invertible.end(),
+                          [](char ok) { return ok; }),
+              "batchInverse: element is not invertible");
+  return res;
+}
+
+std::vector<BigNumber> batchInverse(const std::vector<BigNumber>& a,
+                                    const BigNumber& m) {
+  return batchInverse(a, MontContext(m));
+}
+
+}  // namespace ipcl
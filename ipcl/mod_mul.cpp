@@ -0,0 +1,1053 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ipcl/mod_mul.hpp"
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "ipcl/mod_exp.hpp"
+#include "ipcl/utils/common.hpp"
+#include "ipcl/utils/util.hpp"
+
+namespace ipcl {
+
+constexpr int IPCL_DIGIT_BITS = 52;
+constexpr Ipp64u IPCL_DIGIT_MASK = (1ULL << IPCL_DIGIT_BITS) - 1;
+constexpr int IPCL_MAX_DIGITS =
+    (IPCL_MAX_LIMBS * 64 + 2 + IPCL_DIGIT_BITS - 1) / IPCL_DIGIT_BITS;
+
+// Split 64-bit limbs into 52-bit digits, digit j is written to d[j * stride]
+static void toRadix52(Ipp64u* d, int digits, const Ipp64u* a, int limbs,
+                      int stride = 1) {
+  for (int j = 0; j < digits; j++) {
+    int bit = j * IPCL_DIGIT_BITS;
+    int w = bit / 64, s = bit % 64;
+    Ipp64u v = (w < limbs) ? a[w] >> s : 0;
+    if (s > 64 - IPCL_DIGIT_BITS && w + 1 < limbs) v |= a[w + 1] << (64 - s);
+    d[j * stride] = v & IPCL_DIGIT_MASK;
+  }
+}
+
+// Merge normalized 52-bit digits read from d[j * stride] into 64-bit limbs
+static void fromRadix52(Ipp64u* a, int limbs, const Ipp64u* d, int digits,
+                        int stride = 1) {
+  std::memset(a, 0, limbs * sizeof(Ipp64u));
+  for (int j = 0; j < digits; j++) {
+    int bit = j * IPCL_DIGIT_BITS;
+    int w = bit / 64, s = bit % 64;
+    Ipp64u v = d[j * stride];
+    if (w < limbs) a[w] |= v << s;
+    if (s > 64 - IPCL_DIGIT_BITS && w + 1 < limbs) a[w + 1] |= v >> (64 - s);
+  }
+}
+
+constexpr int IPCL_POW_WINDOW = 4;
+
+// Bits [pos, pos + IPCL_POW_WINDOW) of an exponent of the given bit length
+static std::size_t windowDigit(const Ipp32u* e, int bits, int pos) {
+  std::size_t v = 0;
+  for (int k = IPCL_POW_WINDOW - 1; k >= 0; k--) {
+    int b = pos + k;
+    v = (v << 1) | ((b < bits) ? (e[b / 32] >> (b % 32)) & 1 : 0);
+  }
+  return v;
+}
+
+// Comb digit of a row, bit k * spacing + row of the exponent becomes bit k
+static std::size_t combDigit(const Ipp32u* e, int bits, int window,
+                             int spacing, int row) {
+  std::size_t v = 0;
+  for (int k = 0; k < window; k++) {
+    int pos = k * spacing + row;
+    if (pos < bits)
+      v |= static_cast<std::size_t>((e[pos / 32] >> (pos % 32)) & 1) << k;
+  }
+  return v;
+}
+
+ModMulEngine::ModMulEngine(std::shared_ptr<const MontContext> ctx)
+    : m_ctx(ctx) {
+  const int limbs = m_ctx->getLimbs();
+  const BigNumber& mod = m_ctx->getModulus();
+
+  // R = 2^(52 * digits) > 4m keeps the almost Montgomery product below 2m
+  m_digits = (mod.BitSize() + 2 + IPCL_DIGIT_BITS - 1) / IPCL_DIGIT_BITS;
+  m_k0 = m_ctx->k0() & IPCL_DIGIT_MASK;
+
+  std::vector<Ipp64u> x(limbs);
+  m_mod52.assign(m_digits, 0);
+  toRadix52(m_mod52.data(), m_digits, m_ctx->mod(), limbs);
+
+  int r2_bits = 2 * IPCL_DIGIT_BITS * m_digits;
+  std::vector<Ipp32u> r2_words(r2_bits / 32 + 1, 0);
+  r2_words.back() = 1u << (r2_bits % 32);
+  m_ctx->load(x.data(), BigNumber(r2_words.data(), r2_words.size()));
+  m_r2_52.assign(m_digits, 0);
+  toRadix52(m_r2_52.data(), m_digits, x.data(), limbs);
+
+  int r_bits = IPCL_DIGIT_BITS * m_digits;
+  std::vector<Ipp32u> r_words(r_bits / 32 + 1, 0);
+  r_words.back() = 1u << (r_bits % 32);
+  m_r52 = BigNumber(r_words.data(), r_words.size()) % mod;
+
+  // Radix and accumulator layout of the kernels picked at run time, 8
+  // transposed elements of radix 2^52 digits on the IFMA lanes
+  bool ifma = false;
+#ifdef IPCL_RUNTIME_DETECT_CPU_FEATURES
+  ifma = has_avx512ifma;
+#elif IPCL_CRYPTO_MB_MOD_EXP
+  ifma = true;
+#endif  // IPCL_RUNTIME_DETECT_CPU_FEATURES
+  m_mont_r = ifma ? m_r52 : m_ctx->store(m_ctx->one());
+  m_mont_r2 = ifma ? m_r52 * m_r52 % mod : m_ctx->store(m_ctx->r2());
+
+  // ctx.mul(x * R, R_ctx^2 / R) = x * R_ctx and ctx.mul(x * R_ctx, R) = x * R
+  m_domain.to_ctx.resize(limbs);
+  m_domain.from_ctx.resize(limbs);
+  m_ctx->load(m_domain.to_ctx.data(),
+              m_ctx->store(m_ctx->r2()) * mod.InverseMul(m_mont_r) % mod);
+  m_ctx->load(m_domain.from_ctx.data(), m_mont_r);
+
+  m_acc_lanes = ifma ? IPCL_CRYPTO_MB_SIZE : 1;
+  m_acc_words = ifma ? m_digits : limbs;
+}
+
+void ModMulEngine::modMul(std::vector<BigNumber>& r,
+                          const std::vector<BigNumber>& a,
+                          const std::vector<BigNumber>& b) const {
+  std::size_t v_size = a.size();
+  ERROR_CHECK(b.size() == v_size || b.size() == 1,
+              "modMul: operand size mismatch");
+  r.resize(v_size);
+
+  // A single product would leave 7 of the 8 lanes idle
+  if (v_size == 1) {
+    montModMul(r, a, b);
+    return;
+  }
+
+#ifdef IPCL_RUNTIME_DETECT_CPU_FEATURES
+  if (has_avx512ifma)
+    ifmaModMul(r, a, b);
+  else
+    montModMul(r, a, b);
+#elif IPCL_CRYPTO_MB_MOD_EXP
+  ifmaModMul(r, a, b);
+#else
+  montModMul(r, a, b);
+#endif  // IPCL_RUNTIME_DETECT_CPU_FEATURES
+}
+
+void ModMulEngine::montMul(std::vector<BigNumber>& r,
+                           const std::vector<BigNumber>& a,
+                           const std::vector<BigNumber>& b) const {
+  ERROR_CHECK(b.size() == a.size() || b.size() == 1,
+              "montMul: operand size mismatch");
+  r.resize(a.size());
+
+  // Single products stay on the lanes too, the radix must not change
+#ifdef IPCL_RUNTIME_DETECT_CPU_FEATURES
+  if (has_avx512ifma)
+    ifmaModMul(r, a, b, true);
+  else
+    montModMul(r, a, b, true);
+#elif IPCL_CRYPTO_MB_MOD_EXP
+  ifmaModMul(r, a, b, true);
+#else
+  montModMul(r, a, b, true);
+#endif  // IPCL_RUNTIME_DETECT_CPU_FEATURES
+}
+
+void ModMulEngine::toMont(std::vector<BigNumber>& r,
+                          const std::vector<BigNumber>& a) const {
+  montMul(r, a, {m_mont_r2});
+}
+
+void ModMulEngine::fromMont(std::vector<BigNumber>& r,
+                            const std::vector<BigNumber>& a) const {
+  montMul(r, a, {BigNumber::One()});
+}
+
+void ModMulEngine::montPow(std::vector<BigNumber>& r,
+                           const std::vector<BigNumber>& a,
+                           const std::vector<BigNumber>& exp) const {
+  ERROR_CHECK(exp.size() == a.size() || exp.size() == 1,
+              "montPow: operand size mismatch");
+  for (const BigNumber& e : exp)
+    ERROR_CHECK(e >= BigNumber::Zero(), "montPow: negative exponent");
+  r.resize(a.size());
+
+#ifdef IPCL_RUNTIME_DETECT_CPU_FEATURES
+  if (has_avx512ifma)
+    ifmaMontPow(r, a, exp);
+  else
+    ctxMontPow(r, a, exp);
+#elif IPCL_CRYPTO_MB_MOD_EXP
+  ifmaMontPow(r, a, exp);
+#else
+  ctxMontPow(r, a, exp);
+#endif  // IPCL_RUNTIME_DETECT_CPU_FEATURES
+}
+
+void ModMulEngine::ctxMontPow(std::vector<BigNumber>& r,
+                              const std::vector<BigNumber>& a,
+                              const std::vector<BigNumber>& exp) const {
+  const MontContext& ctx = *m_ctx;
+  std::size_t v_size = a.size();
+  bool broadcast = exp.size() == 1;
+
+#ifdef IPCL_USE_OMP
+  int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, v_size))
+#endif  // IPCL_USE_OMP
+  for (std::size_t i = 0; i < v_size; i++) {
+    IppsBigNumSGN sgn;
+    int bits;
+    Ipp32u* e;
+    ippsRef_BN(&sgn, &bits, &e, BN(exp[broadcast ? 0 : i]));
+
+    // The radix of the engine is the one of ctx, the base is used as is
+    dispatchLimbs(ctx.getLimbs(), [&](auto L) {
+      constexpr int N = decltype(L)::value;
+      const int l = ctx.getLimbs();
+      LimbArray<N> table[1 << IPCL_POW_WINDOW];
+      LimbArray<N> acc;
+      limb::copy<N>(table[0].data(), ctx.one(), l);
+      ctx.load(table[1].data(), a[i]);
+      for (int d = 2; d < (1 << IPCL_POW_WINDOW); d++)
+        ctx.mul<N>(table[d].data(), table[d - 1].data(), table[1].data());
+
+      limb::copy<N>(acc.data(), ctx.one(), l);
+      int top = (bits + IPCL_POW_WINDOW - 1) / IPCL_POW_WINDOW;
+      for (int w = top - 1; w >= 0; w--) {
+        for (int s = 0; s < IPCL_POW_WINDOW; s++)
+          ctx.mul<N>(acc.data(), acc.data(), acc.data());
+        std::size_t d = windowDigit(e, bits, w * IPCL_POW_WINDOW);
+        if (d) ctx.mul<N>(acc.data(), acc.data(), table[d].data());
+      }
+      ctx.store(r[i], acc.data());
+    });
+  }
+}
+
+std::vector<BigNumber> ModMulEngine::modMul(
+    const std::vector<BigNumber>& a, const std::vector<BigNumber>& b) const {
+  std::vector<BigNumber> r(a.size());
+  modMul(r, a, b);
+  return r;
+}
+
+BigNumber ModMulEngine::product(const std::vector<BigNumber>& a,
+                                bool mont) const {
+  std::size_t v_size = a.size();
+  ERROR_CHECK(v_size > 0, "product: Cannot reduce empty vector");
+
+  // One block per thread, but keep blocks long enough to amortize the final
+  // correction of the Montgomery factors
+  constexpr std::size_t min_block = 8 * IPCL_CRYPTO_MB_SIZE;
+  std::size_t blocks = 1;
+#ifdef IPCL_USE_OMP
+  blocks = std::max<std::size_t>(
+      1, std::min<std::size_t>(OMPUtilities::MaxThreads, v_size / min_block));
+#endif  // IPCL_USE_OMP
+  std::size_t block_size = (v_size + blocks - 1) / blocks;
+  blocks = (v_size + block_size - 1) / block_size;
+
+  std::vector<BigNumber> partial(blocks);
+#ifdef IPCL_USE_OMP
+  int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, blocks))
+#endif  // IPCL_USE_OMP
+  for (std::size_t k = 0; k < blocks; k++) {
+    std::size_t begin = k * block_size;
+    std::size_t size = std::min(block_size, v_size - begin);
+    partial[k] = blockProduct(a.data() + begin, size);
+  }
+
+  // Combine the block results pairwise
+  while (partial.size() > 1) {
+    std::size_t half = partial.size() / 2;
+    std::vector<BigNumber> lo(partial.begin(), partial.begin() + half);
+    std::vector<BigNumber> hi(partial.begin() + half,
+                              partial.begin() + 2 * half);
+    modMul(lo, lo, hi);
+    if (partial.size() % 2) lo.push_back(partial.back());
+    partial.swap(lo);
+  }
+
+  // The plain product of size Montgomery operands carries R^size
+  if (!mont || v_size == 1) return partial.front();
+  const BigNumber& mod = m_ctx->getModulus();
+  BigNumber fix = modExp(mod.InverseMul(m_mont_r),
+                         BigNumber(static_cast<Ipp32u>(v_size - 1)), mod);
+  BigNumber res;
+  mulmod_into(res, partial.front(), fix, *m_ctx);
+  return res;
+}
+
+BigNumber ModMulEngine::blockProduct(const BigNumber* a,
+                                     std::size_t size) const {
+  if (size < 2 * IPCL_CRYPTO_MB_SIZE) return montProduct(a, size);
+
+#ifdef IPCL_RUNTIME_DETECT_CPU_FEATURES
+  if (has_avx512ifma)
+    return ifmaProduct(a, size);
+  else
+    return montProduct(a, size);
+#elif IPCL_CRYPTO_MB_MOD_EXP
+  return ifmaProduct(a, size);
+#else
+  return montProduct(a, size);
+#endif  // IPCL_RUNTIME_DETECT_CPU_FEATURES
+}
+
+BigNumber ModMulEngine::montProduct(const BigNumber* a,
+                                    std::size_t size) const {
+  const MontContext& ctx = *m_ctx;
+  BigNumber res;
+
+  // Chain Montgomery products without converting the operands, every step
+  // contributes one R^(-1) factor that is removed at the end
+  dispatchLimbs(ctx.getLimbs(), [&](auto L) {
+    constexpr int N = decltype(L)::value;
+    LimbArray<N> acc, x;
+    ctx.load(acc.data(), a[0]);
+    for (std::size_t i = 1; i < size; i++) {
+      ctx.load(x.data(), a[i]);
+      ctx.mul<N>(acc.data(), acc.data(), x.data());
+    }
+    ctx.store(res, acc.data());
+  });
+
+  if (size == 1) return res;
+  BigNumber r = ctx.store(ctx.one());
+  BigNumber fix = modExp(r, BigNumber(static_cast<Ipp32u>(size - 1)),
+                         ctx.getModulus());
+  mulmod_into(res, res, fix, ctx);
+  return res;
+}
+
+void ModMulEngine::montModMul(std::vector<BigNumber>& r,
+                              const std::vector<BigNumber>& a,
+                              const std::vector<BigNumber>& b,
+                              bool mont) const {
+  std::size_t v_size = a.size();
+  bool broadcast = b.size() == 1;
+  const MontContext& ctx = *m_ctx;
+
+#ifdef IPCL_USE_OMP
+  int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, v_size))
+#endif  // IPCL_USE_OMP
+  for (std::size_t i = 0; i < v_size; i++) {
+    if (!mont) {
+      mulmod_into(r[i], a[i], b[broadcast ? 0 : i], ctx);
+      continue;
+    }
+    dispatchLimbs(ctx.getLimbs(), [&](auto L) {
+      constexpr int N = decltype(L)::value;
+      LimbArray<N> x, y;
+      ctx.load(x.data(), a[i]);
+      ctx.load(y.data(), b[broadcast ? 0 : i]);
+      ctx.mul<N>(x.data(), x.data(), y.data());
+      ctx.store(r[i], x.data());
+    });
+  }
+}
+
+std::vector<Ipp64u> ModMulEngine::accInit(std::size_t size) const {
+  std::size_t groups = (size + m_acc_lanes - 1) / m_acc_lanes;
+  std::vector<Ipp64u> acc(groups * m_acc_words * m_acc_lanes, 0);
+
+  // Lowest word of every element, idle lanes included
+  for (std::size_t g = 0; g < groups; g++)
+    for (int e = 0; e < m_acc_lanes; e++)
+      acc[g * m_acc_words * m_acc_lanes + e] = 1;
+  return acc;
+}
+
+void ModMulEngine::accMul(std::vector<Ipp64u>& acc,
+                          const std::vector<BigNumber>& x) const {
+#ifdef IPCL_RUNTIME_DETECT_CPU_FEATURES
+  if (has_avx512ifma)
+    ifmaAccMul(acc, x);
+  else
+    montAccMul(acc, x);
+#elif IPCL_CRYPTO_MB_MOD_EXP
+  ifmaAccMul(acc, x);
+#else
+  montAccMul(acc, x);
+#endif  // IPCL_RUNTIME_DETECT_CPU_FEATURES
+}
+
+void ModMulEngine::accMerge(std::vector<Ipp64u>& acc,
+                            const std::vector<Ipp64u>& other) const {
+  ERROR_CHECK(acc.size() == other.size(), "accMerge: size mismatch");
+
+#ifdef IPCL_RUNTIME_DETECT_CPU_FEATURES
+  if (has_avx512ifma)
+    ifmaAccMerge(acc, other);
+  else
+    montAccMerge(acc, other);
+#elif IPCL_CRYPTO_MB_MOD_EXP
+  ifmaAccMerge(acc, other);
+#else
+  montAccMerge(acc, other);
+#endif  // IPCL_RUNTIME_DETECT_CPU_FEATURES
+}
+
+void ModMulEngine::accFinalize(std::vector<BigNumber>& r,
+                               const std::vector<Ipp64u>& acc,
+                               std::size_t size, std::size_t shift) const {
+  // acc * R^(shift + 1) / R undoes the pending factors in one product
+  std::uint64_t e = static_cast<std::uint64_t>(shift) + 1;
+  Ipp32u e_words[2] = {static_cast<Ipp32u>(e), static_cast<Ipp32u>(e >> 32)};
+  BigNumber fix = modExp(m_mont_r, BigNumber(e_words, 2), m_ctx->getModulus());
+  std::vector<Ipp64u> t(acc);
+  std::size_t groups = acc.size() / (m_acc_words * m_acc_lanes);
+  accMul(t, std::vector<BigNumber>(groups * m_acc_lanes, fix));
+
+  r.resize(size);
+#ifdef IPCL_RUNTIME_DETECT_CPU_FEATURES
+  if (has_avx512ifma)
+    ifmaAccStore(r, t);
+  else
+    montAccStore(r, t);
+#elif IPCL_CRYPTO_MB_MOD_EXP
+  ifmaAccStore(r, t);
+#else
+  montAccStore(r, t);
+#endif  // IPCL_RUNTIME_DETECT_CPU_FEATURES
+}
+
+void ModMulEngine::montAccMul(std::vector<Ipp64u>& acc,
+                              const std::vector<BigNumber>& x) const {
+  const MontContext& ctx = *m_ctx;
+  const int l = ctx.getLimbs();
+  std::size_t v_size = x.size();
+
+#ifdef IPCL_USE_OMP
+  int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, v_size))
+#endif  // IPCL_USE_OMP
+  for (std::size_t i = 0; i < v_size; i++) {
+    dispatchLimbs(l, [&](auto L) {
+      constexpr int N = decltype(L)::value;
+      LimbArray<N> y;
+      ctx.load(y.data(), x[i]);
+      ctx.mul<N>(acc.data() + i * l, acc.data() + i * l, y.data());
+    });
+  }
+}
+
+void ModMulEngine::montAccMerge(std::vector<Ipp64u>& acc,
+                                const std::vector<Ipp64u>& other) const {
+  const MontContext& ctx = *m_ctx;
+  const int l = ctx.getLimbs();
+  std::size_t v_size = acc.size() / l;
+
+#ifdef IPCL_USE_OMP
+  int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, v_size))
+#endif  // IPCL_USE_OMP
+  for (std::size_t i = 0; i < v_size; i++) {
+    dispatchLimbs(l, [&](auto L) {
+      constexpr int N = decltype(L)::value;
+      ctx.mul<N>(acc.data() + i * l, acc.data() + i * l,
+                 other.data() + i * l);
+    });
+  }
+}
+
+void ModMulEngine::montAccStore(std::vector<BigNumber>& r,
+                                const std::vector<Ipp64u>& acc) const {
+  const int l = m_ctx->getLimbs();
+  for (std::size_t i = 0; i < r.size(); i++)
+    m_ctx->store(r[i], acc.data() + i * l);
+}
+
+std::vector<Ipp64u> ModMulEngine::combTable(const BigNumber& base, int window,
+                                            int spacing) const {
+  ERROR_CHECK(window > 0 && window <= 16 && spacing > 0,
+              "combTable: invalid comb size");
+
+  const MontContext& ctx = *m_ctx;
+  const int l = ctx.getLimbs();
+  std::vector<Ipp64u> table((std::size_t(1) << window) * l);
+
+  // Built in the Montgomery domain of ctx, entry 2^k + v is entry v times
+  // tooth k
+  dispatchLimbs(l, [&](auto L) {
+    constexpr int N = decltype(L)::value;
+    LimbArray<N> g;
+    ctx.load(g.data(), base);
+    ctx.toMont<N>(g.data(), g.data());
+
+    limb::copy<N>(table.data(), ctx.one(), l);
+    for (int k = 0; k < window; k++) {
+      if (k > 0)
+        for (int s = 0; s < spacing; s++)
+          ctx.mul<N>(g.data(), g.data(), g.data());
+
+      const std::size_t top = std::size_t(1) << k;
+      limb::copy<N>(table.data() + top * l, g.data(), l);
+      for (std::size_t v = 1; v < top; v++)
+        ctx.mul<N>(table.data() + (top + v) * l, table.data() + v * l,
+                   g.data());
+    }
+  });
+
+#ifdef IPCL_RUNTIME_DETECT_CPU_FEATURES
+  if (has_avx512ifma) return ifmaCombTable(table);
+#elif IPCL_CRYPTO_MB_MOD_EXP
+  return ifmaCombTable(table);
+#endif  // IPCL_RUNTIME_DETECT_CPU_FEATURES
+  return table;
+}
+
+void ModMulEngine::combPow(std::vector<BigNumber>& r,
+                           const std::vector<const Ipp64u*>& tables,
+                           const std::vector<BigNumber>& exp, int window,
+                           int spacing) const {
+  ERROR_CHECK(tables.size() == exp.size(), "combPow: operand size mismatch");
+  for (const BigNumber& e : exp) {
+    ERROR_CHECK(e >= BigNumber::Zero(), "combPow: negative exponent");
+    ERROR_CHECK(e.BitSize() <= window * spacing,
+                "combPow: exponent is too large");
+  }
+  r.resize(exp.size());
+
+#ifdef IPCL_RUNTIME_DETECT_CPU_FEATURES
+  if (has_avx512ifma)
+    ifmaCombPow(r, tables, exp, window, spacing);
+  else
+    montCombPow(r, tables, exp, window, spacing);
+#elif IPCL_CRYPTO_MB_MOD_EXP
+  ifmaCombPow(r, tables, exp, window, spacing);
+#else
+  montCombPow(r, tables, exp, window, spacing);
+#endif  // IPCL_RUNTIME_DETECT_CPU_FEATURES
+}
+
+void ModMulEngine::montCombPow(std::vector<BigNumber>& r,
+                               const std::vector<const Ipp64u*>& tables,
+                               const std::vector<BigNumber>& exp, int window,
+                               int spacing) const {
+  const MontContext& ctx = *m_ctx;
+  const int l = ctx.getLimbs();
+  std::size_t v_size = exp.size();
+
+#ifdef IPCL_USE_OMP
+  int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, v_size))
+#endif  // IPCL_USE_OMP
+  for (std::size_t i = 0; i < v_size; i++) {
+    IppsBigNumSGN sgn;
+    int bits;
+    Ipp32u* e;
+    ippsRef_BN(&sgn, &bits, &e, BN(exp[i]));
+
+    dispatchLimbs(l, [&](auto L) {
+      constexpr int N = decltype(L)::value;
+      LimbArray<N> acc;
+      limb::copy<N>(acc.data(), ctx.one(), l);
+
+      // Rows above the exponent length have no set bit in any tooth
+      for (int row = std::min(spacing, bits) - 1; row >= 0; row--) {
+        ctx.mul<N>(acc.data(), acc.data(), acc.data());
+        std::size_t v = combDigit(e, bits, window, spacing, row);
+        if (v) ctx.mul<N>(acc.data(), acc.data(), tables[i] + v * l);
+      }
+      ctx.fromMont<N>(acc.data(), acc.data());
+      ctx.store(r[i], acc.data());
+    });
+  }
+}
+
+#if defined(IPCL_RUNTIME_DETECT_CPU_FEATURES) || defined(IPCL_CRYPTO_MB_MOD_EXP)
+
+#define IPCL_TARGET_IFMA __attribute__((target("avx512f,avx512ifma")))
+
+/**
+ * Almost Montgomery multiplication of 8 lanes in radix 2^52,
+ * r = a * b * 2^(-52 * digits) mod m up to one multiple of m.
+ * a and b hold normalized digits below 2m, r is normalized and may alias a
+ * or b. The accumulator digits are normalized only once at the end, each of
+ * them receives fewer than 4 * digits additions of 52-bit values and stays
+ * far from overflowing 64 bits.
+ */
+IPCL_TARGET_IFMA
+static void ifmaAmm52x8(__m512i* r, const __m512i* a, const __m512i* b,
+                        const Ipp64u* m, Ipp64u k0, int digits) {
+  __m512i t[IPCL_MAX_DIGITS + 1];
+  const __m512i zero = _mm512_setzero_si512();
+  const __m512i k = _mm512_set1_epi64(k0);
+
+  for (int j = 0; j <= digits; j++) t[j] = zero;
+
+  for (int i = 0; i < digits; i++) {
+    __m512i bi = b[i];
+    for (int j = 0; j < digits; j++) {
+      t[j] = _mm512_madd52lo_epu64(t[j], a[j], bi);
+      t[j + 1] = _mm512_madd52hi_epu64(t[j + 1], a[j], bi);
+    }
+
+    __m512i u = _mm512_madd52lo_epu64(zero, t[0], k);
+    for (int j = 0; j < digits; j++) {
+      __m512i mj = _mm512_set1_epi64(m[j]);
+      t[j] = _mm512_madd52lo_epu64(t[j], mj, u);
+      t[j + 1] = _mm512_madd52hi_epu64(t[j + 1], mj, u);
+    }
+
+    // The low digit is now a multiple of 2^52, carry it and shift down
+    t[1] = _mm512_add_epi64(t[1], _mm512_srli_epi64(t[0], IPCL_DIGIT_BITS));
+    for (int j = 0; j < digits; j++) t[j] = t[j + 1];
+    t[digits] = zero;
+  }
+
+  const __m512i mask = _mm512_set1_epi64(IPCL_DIGIT_MASK);
+  __m512i carry = zero;
+  for (int j = 0; j < digits; j++) {
+    __m512i v = _mm512_add_epi64(t[j], carry);
+    carry = _mm512_srli_epi64(v, IPCL_DIGIT_BITS);
+    r[j] = _mm512_and_si512(v, mask);
+  }
+}
+
+/**
+ * r = r - m in the lanes where r >= m
+ */
+IPCL_TARGET_IFMA
+static void ifmaSubIfGe52x8(__m512i* r, const Ipp64u* m, int digits) {
+  const __m512i zero = _mm512_setzero_si512();
+  const __m512i mask = _mm512_set1_epi64(IPCL_DIGIT_MASK);
+
+  __m512i borrow = zero;
+  for (int j = 0; j < digits; j++) {
+    __m512i d = _mm512_sub_epi64(r[j], _mm512_set1_epi64(m[j]));
+    d = _mm512_sub_epi64(d, borrow);
+    borrow = _mm512_srli_epi64(d, 63);
+  }
+  __mmask8 ge = _mm512_cmpeq_epi64_mask(borrow, zero);
+
+  borrow = zero;
+  for (int j = 0; j < digits; j++) {
+    __m512i d = _mm512_sub_epi64(r[j], _mm512_set1_epi64(m[j]));
+    d = _mm512_sub_epi64(d, borrow);
+    borrow = _mm512_srli_epi64(d, 63);
+    r[j] = _mm512_mask_mov_epi64(r[j], ge, _mm512_and_si512(d, mask));
+  }
+}
+
+/**
+ * r = a * b mod m for 8 lanes of transposed radix 2^52 digits, or the
+ * Montgomery product a * b * 2^(-52 * digits) mod m when r2 is nullptr
+ */
+IPCL_TARGET_IFMA
+static void ifmaModMul52x8(Ipp64u* r, const Ipp64u* a, const Ipp64u* b,
+                           const Ipp64u* m, const Ipp64u* r2, Ipp64u k0,
+                           int digits) {
+  __m512i t[IPCL_MAX_DIGITS];
+  __m512i r2v[IPCL_MAX_DIGITS];
+
+  ifmaAmm52x8(t, reinterpret_cast<const __m512i*>(a),
+              reinterpret_cast<const __m512i*>(b), m, k0, digits);
+  if (r2) {
+    for (int j = 0; j < digits; j++) r2v[j] = _mm512_set1_epi64(r2[j]);
+    ifmaAmm52x8(t, t, r2v, m, k0, digits);
+  }
+  ifmaSubIfGe52x8(t, m, digits);
+
+  for (int j = 0; j < digits; j++)
+    _mm512_store_si512(reinterpret_cast<__m512i*>(r) + j, t[j]);
+}
+
+void ModMulEngine::ifmaModMul(std::vector<BigNumber>& r,
+                              const std::vector<BigNumber>& a,
+                              const std::vector<BigNumber>& b,
+                              bool mont) const {
+  std::size_t v_size = a.size();
+  bool broadcast = b.size() == 1;
+  const int limbs = m_ctx->getLimbs();
+  const int digits = m_digits;
+  std::size_t chunks = (v_size + IPCL_CRYPTO_MB_SIZE - 1) / IPCL_CRYPTO_MB_SIZE;
+
+#ifdef IPCL_USE_OMP
+  int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, chunks))
+#endif  // IPCL_USE_OMP
+  for (std::size_t c = 0; c < chunks; c++) {
+    alignas(64) Ipp64u x52[IPCL_MAX_DIGITS * IPCL_CRYPTO_MB_SIZE];
+    alignas(64) Ipp64u y52[IPCL_MAX_DIGITS * IPCL_CRYPTO_MB_SIZE];
+    Ipp64u x[IPCL_MAX_LIMBS];
+
+    std::size_t base = c * IPCL_CRYPTO_MB_SIZE;
+    int lanes =
+        static_cast<int>(std::min<std::size_t>(IPCL_CRYPTO_MB_SIZE,
+                                               v_size - base));
+    std::memset(x52, 0, sizeof(Ipp64u) * digits * IPCL_CRYPTO_MB_SIZE);
+    std::memset(y52, 0, sizeof(Ipp64u) * digits * IPCL_CRYPTO_MB_SIZE);
+
+    for (int e = 0; e < lanes; e++) {
+      m_ctx->load(x, a[base + e]);
+      toRadix52(x52 + e, digits, x, limbs, IPCL_CRYPTO_MB_SIZE);
+      m_ctx->load(x, b[broadcast ? 0 : base + e]);
+      toRadix52(y52 + e, digits, x, limbs, IPCL_CRYPTO_MB_SIZE);
+    }
+
+    ifmaModMul52x8(x52, x52, y52, m_mod52.data(),
+                   mont ? nullptr : m_r2_52.data(), m_k0, digits);
+
+    for (int e = 0; e < lanes; e++) {
+      fromRadix52(x, limbs, x52 + e, digits, IPCL_CRYPTO_MB_SIZE);
+      m_ctx->store(r[base + e], x);
+    }
+  }
+}
+
+IPCL_TARGET_IFMA
+static void ifmaMulAcc52x8(Ipp64u* acc, const Ipp64u* x, const Ipp64u* m,
+                           Ipp64u k0, int digits) {
+  __m512i* t = reinterpret_cast<__m512i*>(acc);
+  ifmaAmm52x8(t, t, reinterpret_cast<const __m512i*>(x), m, k0, digits);
+}
+
+IPCL_TARGET_IFMA
+static void ifmaReduce52x8(Ipp64u* acc, const Ipp64u* m, int digits) {
+  ifmaSubIfGe52x8(reinterpret_cast<__m512i*>(acc), m, digits);
+}
+
+BigNumber ModMulEngine::ifmaProduct(const BigNumber* a,
+                                    std::size_t size) const {
+  const int limbs = m_ctx->getLimbs();
+  const int digits = m_digits;
+  const std::size_t groups =
+      (size + IPCL_CRYPTO_MB_SIZE - 1) / IPCL_CRYPTO_MB_SIZE;
+
+  alignas(64) Ipp64u acc[IPCL_MAX_DIGITS * IPCL_CRYPTO_MB_SIZE];
+  alignas(64) Ipp64u x52[IPCL_MAX_DIGITS * IPCL_CRYPTO_MB_SIZE];
+  Ipp64u x[IPCL_MAX_LIMBS];
+
+  // Lane e accumulates elements e, e + 8, e + 16, ... Missing elements of the
+  // last group are padded with 1, so every lane goes through the same number
+  // of almost Montgomery products. The lanes stay below 2m and are only fully
+  // reduced once at the end.
+  auto load_group = [&](Ipp64u* dst, std::size_t g) {
+    std::memset(dst, 0, sizeof(Ipp64u) * digits * IPCL_CRYPTO_MB_SIZE);
+    for (int e = 0; e < IPCL_CRYPTO_MB_SIZE; e++) {
+      std::size_t i = g * IPCL_CRYPTO_MB_SIZE + e;
+      if (i < size) {
+        m_ctx->load(x, a[i]);
+        toRadix52(dst + e, digits, x, limbs, IPCL_CRYPTO_MB_SIZE);
+      } else {
+        dst[e] = 1;
+      }
+    }
+  };
+
+  load_group(acc, 0);
+  for (std::size_t g = 1; g < groups; g++) {
+    load_group(x52, g);
+    ifmaMulAcc52x8(acc, x52, m_mod52.data(), m_k0, digits);
+  }
+  ifmaReduce52x8(acc, m_mod52.data(), digits);
+
+  BigNumber res, lane;
+  for (int e = 0; e < IPCL_CRYPTO_MB_SIZE; e++) {
+    fromRadix52(x, limbs, acc + e, digits, IPCL_CRYPTO_MB_SIZE);
+    if (e == 0) {
+      m_ctx->store(res, x);
+    } else {
+      m_ctx->store(lane, x);
+      mulmod_into(res, res, lane, *m_ctx);
+    }
+  }
+
+  // Each lane carries R^(-(groups - 1)) with R = 2^(52 * digits)
+  BigNumber fix = modExp(
+      m_r52,
+      BigNumber(static_cast<Ipp32u>(IPCL_CRYPTO_MB_SIZE * (groups - 1))),
+      m_ctx->getModulus());
+  mulmod_into(res, res, fix, *m_ctx);
+  return res;
+}
+
+std::vector<Ipp64u> ModMulEngine::ifmaCombTable(
+    const std::vector<Ipp64u>& mont) const {
+  const int limbs = m_ctx->getLimbs();
+  const int digits = m_digits;
+  const std::size_t entries = mont.size() / limbs;
+  std::vector<Ipp64u> table(entries * digits);
+
+  alignas(64) Ipp64u x52[IPCL_MAX_DIGITS * IPCL_CRYPTO_MB_SIZE];
+  alignas(64) Ipp64u r2[IPCL_MAX_DIGITS * IPCL_CRYPTO_MB_SIZE];
+  Ipp64u x[IPCL_MAX_LIMBS];
+  for (int j = 0; j < digits; j++)
+    for (int e = 0; e < IPCL_CRYPTO_MB_SIZE; e++)
+      r2[j * IPCL_CRYPTO_MB_SIZE + e] = m_r2_52[j];
+
+  // Move the entries from the 2^64 Montgomery domain of the context to the
+  // 2^52 one of the lanes, 8 entries at a time
+  for (std::size_t base = 0; base < entries; base += IPCL_CRYPTO_MB_SIZE) {
+    int lanes = static_cast<int>(
+        std::min<std::size_t>(IPCL_CRYPTO_MB_SIZE, entries - base));
+    std::memset(x52, 0, sizeof(Ipp64u) * digits * IPCL_CRYPTO_MB_SIZE);
+    for (int e = 0; e < lanes; e++) {
+      dispatchLimbs(limbs, [&](auto L) {
+        constexpr int N = decltype(L)::value;
+        m_ctx->fromMont<N>(x, mont.data() + (base + e) * limbs);
+      });
+      toRadix52(x52 + e, digits, x, limbs, IPCL_CRYPTO_MB_SIZE);
+    }
+
+    ifmaMulAcc52x8(x52, r2, m_mod52.data(), m_k0, digits);
+    ifmaReduce52x8(x52, m_mod52.data(), digits);
+
+    for (int e = 0; e < lanes; e++)
+      for (int j = 0; j < digits; j++)
+        table[(base + e) * digits + j] = x52[j * IPCL_CRYPTO_MB_SIZE + e];
+  }
+  return table;
+}
+
+void ModMulEngine::ifmaCombPow(std::vector<BigNumber>& r,
+                               const std::vector<const Ipp64u*>& tables,
+                               const std::vector<BigNumber>& exp, int window,
+                               int spacing) const {
+  const int limbs = m_ctx->getLimbs();
+  const int digits = m_digits;
+  std::size_t v_size = exp.size();
+  std::size_t chunks = (v_size + IPCL_CRYPTO_MB_SIZE - 1) / IPCL_CRYPTO_MB_SIZE;
+
+#ifdef IPCL_USE_OMP
+  int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, chunks))
+#endif  // IPCL_USE_OMP
+  for (std::size_t c = 0; c < chunks; c++) {
+    alignas(64) Ipp64u acc[IPCL_MAX_DIGITS * IPCL_CRYPTO_MB_SIZE];
+    alignas(64) Ipp64u y52[IPCL_MAX_DIGITS * IPCL_CRYPTO_MB_SIZE];
+    Ipp64u x[IPCL_MAX_LIMBS];
+    const Ipp32u* e_data[IPCL_CRYPTO_MB_SIZE];
+    int e_bits[IPCL_CRYPTO_MB_SIZE] = {0};
+
+    std::size_t base = c * IPCL_CRYPTO_MB_SIZE;
+    int lanes = static_cast<int>(
+        std::min<std::size_t>(IPCL_CRYPTO_MB_SIZE, v_size - base));
+    int max_bits = 0;
+    for (int e = 0; e < lanes; e++) {
+      IppsBigNumSGN sgn;
+      Ipp32u* data;
+      ippsRef_BN(&sgn, &e_bits[e], &data, BN(exp[base + e]));
+      e_data[e] = data;
+      max_bits = std::max(max_bits, e_bits[e]);
+    }
+
+    // Entry 0 of every table is R mod m, idle lanes multiply by it too and
+    // stay at one
+    for (int j = 0; j < digits; j++)
+      for (int e = 0; e < IPCL_CRYPTO_MB_SIZE; e++)
+        acc[j * IPCL_CRYPTO_MB_SIZE + e] = tables[base][j];
+
+    for (int row = std::min(spacing, max_bits) - 1; row >= 0; row--) {
+      ifmaMulAcc52x8(acc, acc, m_mod52.data(), m_k0, digits);
+      for (int e = 0; e < IPCL_CRYPTO_MB_SIZE; e++) {
+        const Ipp64u* src = tables[base];
+        if (e < lanes)
+          src = tables[base + e] +
+                combDigit(e_data[e], e_bits[e], window, spacing, row) * digits;
+        for (int j = 0; j < digits; j++)
+          y52[j * IPCL_CRYPTO_MB_SIZE + e] = src[j];
+      }
+      ifmaMulAcc52x8(acc, y52, m_mod52.data(), m_k0, digits);
+    }
+
+    // Leave the Montgomery domain by multiplying with 1
+    std::memset(y52, 0, sizeof(Ipp64u) * digits * IPCL_CRYPTO_MB_SIZE);
+    for (int e = 0; e < IPCL_CRYPTO_MB_SIZE; e++) y52[e] = 1;
+    ifmaMulAcc52x8(acc, y52, m_mod52.data(), m_k0, digits);
+    ifmaReduce52x8(acc, m_mod52.data(), digits);
+
+    for (int e = 0; e < lanes; e++) {
+      fromRadix52(x, limbs, acc + e, digits, IPCL_CRYPTO_MB_SIZE);
+      m_ctx->store(r[base + e], x);
+    }
+  }
+}
+
+void ModMulEngine::ifmaMontPow(std::vector<BigNumber>& r,
+                               const std::vector<BigNumber>& a,
+                               const std::vector<BigNumber>& exp) const {
+  const int limbs = m_ctx->getLimbs();
+  const int digits = m_digits;
+  constexpr int entries = 1 << IPCL_POW_WINDOW;
+  const std::size_t lane_words = digits * IPCL_CRYPTO_MB_SIZE;
+  std::size_t v_size = a.size();
+  bool broadcast = exp.size() == 1;
+  std::size_t chunks = (v_size + IPCL_CRYPTO_MB_SIZE - 1) / IPCL_CRYPTO_MB_SIZE;
+
+  // R mod m, the Montgomery form of 1, on every lane
+  std::vector<Ipp64u> one52(lane_words);
+  Ipp64u one[IPCL_MAX_LIMBS];
+  m_ctx->load(one, m_r52);
+  for (int e = 0; e < IPCL_CRYPTO_MB_SIZE; e++)
+    toRadix52(one52.data() + e, digits, one, limbs, IPCL_CRYPTO_MB_SIZE);
+
+#ifdef IPCL_USE_OMP
+  int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, chunks))
+#endif  // IPCL_USE_OMP
+  for (std::size_t c = 0; c < chunks; c++) {
+    alignas(64) Ipp64u acc[IPCL_MAX_DIGITS * IPCL_CRYPTO_MB_SIZE];
+    alignas(64) Ipp64u x52[IPCL_MAX_DIGITS * IPCL_CRYPTO_MB_SIZE];
+    alignas(64) Ipp64u y52[IPCL_MAX_DIGITS * IPCL_CRYPTO_MB_SIZE];
+    Ipp64u x[IPCL_MAX_LIMBS];
+    const Ipp32u* e_data[IPCL_CRYPTO_MB_SIZE];
+    int e_bits[IPCL_CRYPTO_MB_SIZE] = {0};
+    std::vector<Ipp64u> table(entries * lane_words);
+    const std::size_t bytes = sizeof(Ipp64u) * lane_words;
+
+    std::size_t base = c * IPCL_CRYPTO_MB_SIZE;
+    int lanes = static_cast<int>(
+        std::min<std::size_t>(IPCL_CRYPTO_MB_SIZE, v_size - base));
+    int max_bits = 0;
+    std::memset(x52, 0, bytes);
+    for (int e = 0; e < lanes; e++) {
+      m_ctx->load(x, a[base + e]);
+      toRadix52(x52 + e, digits, x, limbs, IPCL_CRYPTO_MB_SIZE);
+      IppsBigNumSGN sgn;
+      Ipp32u* data;
+      ippsRef_BN(&sgn, &e_bits[e], &data,
+                 BN(exp[broadcast ? 0 : base + e]));
+      e_data[e] = data;
+      max_bits = std::max(max_bits, e_bits[e]);
+    }
+
+    // Entry d of lane e is table[(d * digits + j) * 8 + e], entry 0 is
+    // R mod m and the bases are already multiplied by R
+    std::memcpy(table.data(), one52.data(), bytes);
+    std::memcpy(table.data() + lane_words, x52, bytes);
+    std::memcpy(y52, x52, bytes);
+    for (int d = 2; d < entries; d++) {
+      ifmaModMul52x8(y52, y52, x52, m_mod52.data(), nullptr, m_k0, digits);
+      std::memcpy(table.data() + d * lane_words, y52, bytes);
+    }
+
+    // Lanes with shorter exponents multiply by entry 0 at the top
+    std::memcpy(acc, one52.data(), bytes);
+    int top = (max_bits + IPCL_POW_WINDOW - 1) / IPCL_POW_WINDOW;
+    for (int w = top - 1; w >= 0; w--) {
+      for (int s = 0; s < IPCL_POW_WINDOW; s++)
+        ifmaMulAcc52x8(acc, acc, m_mod52.data(), m_k0, digits);
+      for (int e = 0; e < IPCL_CRYPTO_MB_SIZE; e++) {
+        std::size_t d = 0;
+        if (e < lanes)
+          d = windowDigit(e_data[e], e_bits[e], w * IPCL_POW_WINDOW);
+        const Ipp64u* src = table.data() + d * lane_words + e;
+        for (int j = 0; j < digits; j++)
+          y52[j * IPCL_CRYPTO_MB_SIZE + e] = src[j * IPCL_CRYPTO_MB_SIZE];
+      }
+      ifmaMulAcc52x8(acc, y52, m_mod52.data(), m_k0, digits);
+    }
+    ifmaReduce52x8(acc, m_mod52.data(), digits);
+
+    for (int e = 0; e < lanes; e++) {
+      fromRadix52(x, limbs, acc + e, digits, IPCL_CRYPTO_MB_SIZE);
+      m_ctx->store(r[base + e], x);
+    }
+  }
+}
+
+void ModMulEngine::ifmaAccMul(std::vector<Ipp64u>& acc,
+                              const std::vector<BigNumber>& x) const {
+  const int limbs = m_ctx->getLimbs();
+  const int digits = m_digits;
+  std::size_t v_size = x.size();
+  std::size_t chunks = (v_size + IPCL_CRYPTO_MB_SIZE - 1) / IPCL_CRYPTO_MB_SIZE;
+
+#ifdef IPCL_USE_OMP
+  int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, chunks))
+#endif  // IPCL_USE_OMP
+  for (std::size_t c = 0; c < chunks; c++) {
+    alignas(64) Ipp64u x52[IPCL_MAX_DIGITS * IPCL_CRYPTO_MB_SIZE];
+    Ipp64u t[IPCL_MAX_LIMBS];
+
+    std::size_t base = c * IPCL_CRYPTO_MB_SIZE;
+    int lanes = static_cast<int>(
+        std::min<std::size_t>(IPCL_CRYPTO_MB_SIZE, v_size - base));
+    std::memset(x52, 0, sizeof(Ipp64u) * digits * IPCL_CRYPTO_MB_SIZE);
+    for (int e = 0; e < lanes; e++) {
+      m_ctx->load(t, x[base + e]);
+      toRadix52(x52 + e, digits, t, limbs, IPCL_CRYPTO_MB_SIZE);
+    }
+
+    // No conditional subtraction, the lanes stay below 2m. The kernels need
+    // 64-byte aligned operands, the vector storage is not.
+    alignas(64) Ipp64u a52[IPCL_MAX_DIGITS * IPCL_CRYPTO_MB_SIZE];
+    std::size_t bytes = sizeof(Ipp64u) * digits * IPCL_CRYPTO_MB_SIZE;
+    Ipp64u* chunk = acc.data() + c * digits * IPCL_CRYPTO_MB_SIZE;
+    std::memcpy(a52, chunk, bytes);
+    ifmaMulAcc52x8(a52, x52, m_mod52.data(), m_k0, digits);
+    std::memcpy(chunk, a52, bytes);
+  }
+}
+
+void ModMulEngine::ifmaAccMerge(std::vector<Ipp64u>& acc,
+                                const std::vector<Ipp64u>& other) const {
+  const int digits = m_digits;
+  std::size_t chunks = acc.size() / (digits * IPCL_CRYPTO_MB_SIZE);
+
+#ifdef IPCL_USE_OMP
+  int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, chunks))
+#endif  // IPCL_USE_OMP
+  for (std::size_t c = 0; c < chunks; c++) {
+    alignas(64) Ipp64u a52[IPCL_MAX_DIGITS * IPCL_CRYPTO_MB_SIZE];
+    alignas(64) Ipp64u b52[IPCL_MAX_DIGITS * IPCL_CRYPTO_MB_SIZE];
+    std::size_t offset = c * digits * IPCL_CRYPTO_MB_SIZE;
+    std::size_t bytes = sizeof(Ipp64u) * digits * IPCL_CRYPTO_MB_SIZE;
+    std::memcpy(a52, acc.data() + offset, bytes);
+    std::memcpy(b52, other.data() + offset, bytes);
+    ifmaMulAcc52x8(a52, b52, m_mod52.data(), m_k0, digits);
+    std::memcpy(acc.data() + offset, a52, bytes);
+  }
+}
+
+void ModMulEngine::ifmaAccStore(std::vector<BigNumber>& r,
+                                const std::vector<Ipp64u>& acc) const {
+  const int limbs = m_ctx->getLimbs();
+  const int digits = m_digits;
+  alignas(64) Ipp64u t[IPCL_MAX_DIGITS * IPCL_CRYPTO_MB_SIZE];
+  Ipp64u x[IPCL_MAX_LIMBS];
+
+  for (std::size_t base = 0; base < r.size(); base += IPCL_CRYPTO_MB_SIZE) {
+    std::memcpy(t, acc.data() + base * digits,
+                sizeof(Ipp64u) * digits * IPCL_CRYPTO_MB_SIZE);
+    ifmaReduce52x8(t, m_mod52.data(), digits);
+
+    int lanes = static_cast<int>(
+        std::min<std::size_t>(IPCL_CRYPTO_MB_SIZE, r.size() - base));
+    for (int e = 0; e < lanes; e++) {
+      fromRadix52(x, limbs, t + e, digits, IPCL_CRYPTO_MB_SIZE);
+      m_ctx->store(r[base + e], x);
+    }
+  }
+}
+
+#endif  // IPCL_RUNTIME_DETECT_CPU_FEATURES || IPCL_CRYPTO_MB_MOD_EXP
+
+}  // namespace ipcl
@@ -0,0 +1,272 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ipcl/mod_reduce.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "ipcl/utils/util.hpp"
+
+namespace ipcl {
+
+namespace {
+
+// Barrett reduction (HAC 14.42) with base 2^64, r = x mod m for x of 2 * l
+// limbs, m of l limbs and mu = floor(2^(128 * l) / m) of l + 1 limbs. The
+// estimated quotient is at most 2 below the true one.
+template <int N>
+void barrettReduce(Ipp64u* r, const Ipp64u* x, const Ipp64u* m,
+                   const Ipp64u* mu, int n) {
+  const int l = limb::len<N>(n);
+
+  // q = floor(floor(x / 2^(64 * (l - 1))) * mu / 2^(64 * (l + 1)))
+  const Ipp64u* q1 = x + l - 1;
+  Ipp64u q2[2 * limb::len<N>(IPCL_MAX_LIMBS) + 2];
+  for (int i = 0; i < 2 * l + 2; i++) q2[i] = 0;
+  for (int i = 0; i <= l; i++) {
+    Ipp64u carry = 0;
+    Ipp64u qi = q1[i];
+    IPCL_UNROLL
+    for (int j = 0; j <= l; j++) {
+      limb::u128 s =
+          static_cast<limb::u128>(qi) * mu[j] + q2[i + j] + carry;
+      q2[i + j] = static_cast<Ipp64u>(s);
+      carry = static_cast<Ipp64u>(s >> 64);
+    }
+    q2[i + l + 1] = carry;
+  }
+  const Ipp64u* q = q2 + l + 1;
+
+  // t = q * m mod 2^(64 * (l + 1))
+  Ipp64u t[limb::len<N>(IPCL_MAX_LIMBS) + 1];
+  for (int i = 0; i <= l; i++) t[i] = 0;
+  for (int i = 0; i <= l; i++) {
+    Ipp64u carry = 0;
+    Ipp64u qi = q[i];
+    for (int j = 0; j < l && i + j <= l; j++) {
+      limb::u128 s =
+          static_cast<limb::u128>(qi) * m[j] + t[i + j] + carry;
+      t[i + j] = static_cast<Ipp64u>(s);
+      carry = static_cast<Ipp64u>(s >> 64);
+    }
+    if (i == 0) t[l] = carry;
+  }
+
+  // r = x - t mod 2^(64 * (l + 1)), then at most two corrections
+  Ipp64u borrow = limb::sub<N>(t, x, t, l);
+  t[l] = x[l] - t[l] - borrow;
+  while (t[l] || limb::cmp<N>(t, m, l) >= 0) {
+    borrow = limb::sub<N>(t, t, m, l);
+    t[l] -= borrow;
+  }
+  limb::copy<N>(r, t, l);
+}
+
+void storeLimbs(BigNumber& out, const Ipp64u* a, int limbs) {
+  out.Reserve(limbs * 2);
+  out.Set(reinterpret_cast<const Ipp32u*>(a), limbs * 2);
+}
+
+}  // namespace
+
+ModReducer::ModReducer(const BigNumber& mod, Method method)
+    : m_method(method), m_limbs(BITSIZE_DWORD(mod.BitSize())), m_mod_bn(mod) {
+  ERROR_CHECK(mod > BigNumber::One(), "ModReducer: modulus must exceed 1");
+  ERROR_CHECK(m_limbs <= IPCL_MAX_LIMBS, "ModReducer: modulus is too large");
+
+  if (method == Method::Montgomery) {
+    m_mont = std::make_shared<const MontContext>(mod);
+    m_mod.assign(m_mont->mod(), m_mont->mod() + m_limbs);
+    return;
+  }
+
+  int bits;
+  Ipp32u* data;
+  m_mod.assign(m_limbs, 0);
+  ippsRef_BN(nullptr, &bits, &data, BN(mod));
+  std::memcpy(m_mod.data(), data, BITSIZE_WORD(bits) * sizeof(Ipp32u));
+
+  std::vector<Ipp32u> r_words(m_limbs * 4 + 1, 0);
+  r_words.back() = 1;
+  BigNumber mu = BigNumber(r_words.data(), r_words.size()) / mod;
+  ippsRef_BN(nullptr, &bits, &data, BN(mu));
+  ERROR_CHECK(BITSIZE_DWORD(bits) <= m_limbs + 1,
+              "ModReducer: modulus must not be a power of 2^64");
+  m_mu.assign(m_limbs + 1, 0);
+  std::memcpy(m_mu.data(), data, BITSIZE_WORD(bits) * sizeof(Ipp32u));
+}
+
+ModReducer::ModReducer(std::shared_ptr<const MontContext> ctx)
+    : m_method(Method::Montgomery),
+      m_limbs(ctx->getLimbs()),
+      m_mod_bn(ctx->getModulus()),
+      m_mod(ctx->mod(), ctx->mod() + ctx->getLimbs()),
+      m_mont(ctx) {}
+
+template <int N>
+void ModReducer::reduceWide(Ipp64u* r, const Ipp64u* x) const {
+  if (m_mont)
+    m_mont->reduce<N>(r, x);
+  else
+    barrettReduce<N>(r, x, m_mod.data(), m_mu.data(), m_limbs);
+}
+
+template <int N>
+void ModReducer::loadLimbs(Ipp64u* r, const BigNumber& a) const {
+  const int l = m_limbs;
+  IppsBigNumSGN sgn;
+  int bits;
+  Ipp32u* data;
+  ippsRef_BN(&sgn, &bits, &data, BN(a));
+  const int words = BITSIZE_WORD(bits);
+
+  Ipp64u x[2 * limb::len<N>(IPCL_MAX_LIMBS)];
+  if (BITSIZE_DWORD(bits) <= 2 * l) {
+    std::memset(x, 0, 2 * l * sizeof(Ipp64u));
+    std::memcpy(x, data, words * sizeof(Ipp32u));
+    if (BITSIZE_DWORD(bits) <= l && limb::cmp<N>(x, m_mod.data(), l) < 0)
+      limb::copy<N>(r, x, l);
+    else
+      reduceWide<N>(r, x);
+  } else {
+    // Wider inputs by Horner's rule over blocks of l limbs from the top,
+    // r = (r * 2^(64 * l) + block) mod m with every step below m * 2^(64 * l)
+    limb::zero<N>(r, l);
+    for (int b = (BITSIZE_DWORD(bits) - 1) / l; b >= 0; b--) {
+      const int first = 2 * l * b;
+      std::memset(x, 0, 2 * l * sizeof(Ipp64u));
+      std::memcpy(x, data + first,
+                  std::min(words - first, 2 * l) * sizeof(Ipp32u));
+      limb::copy<N>(x + l, r, l);
+      reduceWide<N>(r, x);
+    }
+  }
+
+  // -a mod m = m - (|a| mod m)
+  if (sgn == IppsBigNumNEG) {
+    Ipp64u nonzero = 0;
+    for (int i = 0; i < l; i++) nonzero |= r[i];
+    if (nonzero) limb::sub<N>(r, m_mod.data(), r, l);
+  }
+}
+
+void ModReducer::load(Ipp64u* r, const BigNumber& a) const {
+  dispatchLimbs(m_limbs, [&](auto L) {
+    constexpr int N = decltype(L)::value;
+    loadLimbs<N>(r, a);
+  });
+}
+
+void ModReducer::reduceOne(BigNumber& out, const BigNumber& a) const {
+  dispatchLimbs(m_limbs, [&](auto L) {
+    constexpr int N = decltype(L)::value;
+    LimbArray<N> x;
+    loadLimbs<N>(x.data(), a);
+    storeLimbs(out, x.data(), m_limbs);
+  });
+}
+
+void ModReducer::mulmodOne(BigNumber& out, const BigNumber& a,
+                           const BigNumber& b) const {
+  dispatchLimbs(m_limbs, [&](auto L) {
+    constexpr int N = decltype(L)::value;
+    LimbArray<N> x, y;
+    loadLimbs<N>(x.data(), a);
+    loadLimbs<N>(y.data(), b);
+    if (m_mont) {
+      m_mont->modMul<N>(x.data(), x.data(), y.data());
+    } else {
+      Ipp64u u[2 * limb::len<N>(IPCL_MAX_LIMBS)];
+      limb::mul<N>(u, x.data(), y.data(), m_limbs);
+      reduceWide<N>(x.data(), u);
+    }
+    storeLimbs(out, x.data(), m_limbs);
+  });
+}
+
+void ModReducer::addmodOne(BigNumber& out, const BigNumber& a,
+                           const BigNumber& b) const {
+  dispatchLimbs(m_limbs, [&](auto L) {
+    constexpr int N = decltype(L)::value;
+    LimbArray<N> x, y;
+    loadLimbs<N>(x.data(), a);
+    loadLimbs<N>(y.data(), b);
+    Ipp64u carry = limb::add<N>(x.data(), x.data(), y.data(), m_limbs);
+    if (carry || limb::cmp<N>(x.data(), m_mod.data(), m_limbs) >= 0)
+      limb::sub<N>(x.data(), x.data(), m_mod.data(), m_limbs);
+    storeLimbs(out, x.data(), m_limbs);
+  });
+}
+
+void ModReducer::reduce(std::vector<BigNumber>& r,
+                        const std::vector<BigNumber>& a) const {
+  const std::size_t v_size = a.size();
+  r.resize(v_size);
+
+#ifdef IPCL_USE_OMP
+  int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, v_size))
+#endif  // IPCL_USE_OMP
+  for (std::size_t i = 0; i < v_size; i++) reduceOne(r[i], a[i]);
+}
+
+void ModReducer::mulmod(std::vector<BigNumber>& r,
+                        const std::vector<BigNumber>& a,
+                        const std::vector<BigNumber>& b) const {
+  const std::size_t v_size = a.size();
+  ERROR_CHECK(b.size() == v_size || b.size() == 1,
+              "ModReducer: operand size mismatch");
+  const bool bcast = b.size() == 1 && v_size != 1;
+  // Keep the broadcast operand alive if r aliases b
+  const BigNumber b0 = bcast ? b.front() : BigNumber::Zero();
+  r.resize(v_size);
+
+#ifdef IPCL_USE_OMP
+  int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, v_size))
+#endif  // IPCL_USE_OMP
+  for (std::size_t i = 0; i < v_size; i++)
+    mulmodOne(r[i], a[i], bcast ? b0 : b[i]);
+}
+
+void ModReducer::addmod(std::vector<BigNumber>& r,
+                        const std::vector<BigNumber>& a,
+                        const std::vector<BigNumber>& b) const {
+  const std::size_t v_size = a.size();
+  ERROR_CHECK(b.size() == v_size || b.size() == 1,
+              "ModReducer: operand size mismatch");
+  const bool bcast = b.size() == 1 && v_size != 1;
+  const BigNumber b0 = bcast ? b.front() : BigNumber::Zero();
+  r.resize(v_size);
+
+#ifdef IPCL_USE_OMP
+  int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, v_size))
+#endif  // IPCL_USE_OMP
+  for (std::size_t i = 0; i < v_size; i++)
+    addmodOne(r[i], a[i], bcast ? b0 : b[i]);
+}
+
+BigNumber ModReducer::reduce(const BigNumber& a) const {
+  BigNumber r;
+  reduceOne(r, a);
+  return r;
+}
+
+BigNumber ModReducer::mulmod(const BigNumber& a, const BigNumber& b) const {
+  BigNumber r;
+  mulmodOne(r, a, b);
+  return r;
+}
+
+BigNumber ModReducer::addmod(const BigNumber& a, const BigNumber& b) const {
+  BigNumber r;
+  addmodOne(r, a, b);
+  return r;
+}
+
+}  // namespace ipcl
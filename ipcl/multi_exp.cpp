@@ -0,0 +1,401 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ipcl/multi_exp.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "ipcl/utils/util.hpp"
+
+namespace ipcl {
+
+namespace {
+
+// Read-only view of the 32-bit words of an exponent
+struct ExpRef {
+  const Ipp32u* data;
+  int words;
+  int bits;
+};
+
+// w bits of e starting at bit pos, w <= 32
+inline Ipp32u expDigit(const ExpRef& e, int pos, int w) {
+  int idx = pos / 32, sh = pos % 32;
+  if (idx >= e.words) return 0;
+  Ipp64u v = e.data[idx];
+  if (idx + 1 < e.words) v |= static_cast<Ipp64u>(e.data[idx + 1]) << 32;
+  return static_cast<Ipp32u>((v >> sh) & ((1ULL << w) - 1));
+}
+
+// Conversion factors of dom, the normal form when dom is nullptr
+MontDomain domainOf(const MontContext& ctx, const MontDomain* dom) {
+  if (dom) return *dom;
+  const int l = ctx.getLimbs();
+  MontDomain normal;
+  normal.to_ctx.assign(ctx.r2(), ctx.r2() + l);
+  normal.from_ctx.assign(l, 0);
+  normal.from_ctx[0] = 1;
+  return normal;
+}
+
+constexpr int IPCL_STRAUS_WINDOW = 4;
+
+/**
+ * Straus' interleaved windows: one table of 2^w powers per base, then a
+ * single chain of squarings shared by all bases. The bases are moved into
+ * the context domain by to_ctx, r is in Montgomery form.
+ */
+template <int N>
+void strausBlock(Ipp64u* r, const MontContext& ctx, const Ipp64u* to_ctx,
+                 const BigNumber* base, const ExpRef* exp, std::size_t k,
+                 int bits) {
+  const int l = ctx.getLimbs();
+  constexpr int w = IPCL_STRAUS_WINDOW;
+  constexpr int t_size = 1 << w;
+
+  std::vector<Ipp64u> table(k * t_size * l);
+  auto entry = [&](std::size_t i, int d) {
+    return table.data() + (i * t_size + d) * l;
+  };
+
+  LimbArray<N> x;
+  for (std::size_t i = 0; i < k; i++) {
+    ctx.load(x.data(), base[i]);
+    limb::copy<N>(entry(i, 0), ctx.one(), l);
+    ctx.mul<N>(entry(i, 1), x.data(), to_ctx);
+    for (int d = 2; d < t_size; d++)
+      ctx.mul<N>(entry(i, d), entry(i, d - 1), entry(i, 1));
+  }
+
+  bool started = false;
+  limb::copy<N>(r, ctx.one(), l);
+  for (int win = (bits + w - 1) / w - 1; win >= 0; win--) {
+    if (started)
+      for (int s = 0; s < w; s++) ctx.mul<N>(r, r, r);
+    for (std::size_t i = 0; i < k; i++) {
+      Ipp32u d = expDigit(exp[i], win * w, w);
+      if (!d) continue;
+      if (started) {
+        ctx.mul<N>(r, r, entry(i, d));
+      } else {
+        limb::copy<N>(r, entry(i, d), l);
+        started = true;
+      }
+    }
+  }
+}
+
+/**
+ * Pippenger's bucket method: for every c-bit window the bases are sorted
+ * into 2^c - 1 buckets by digit, and sum(d * B_d) is obtained with two
+ * running products. The bases are moved into the context domain by to_ctx,
+ * r is in Montgomery form.
+ */
+template <int N>
+void pippengerBlock(Ipp64u* r, const MontContext& ctx, const Ipp64u* to_ctx,
+                    const BigNumber* base, const ExpRef* exp, std::size_t k,
+                    int bits) {
+  const int l = ctx.getLimbs();
+
+  int log_k = 0;
+  while ((std::size_t(2) << log_k) <= k) log_k++;
+  const int c = std::min(14, std::max(4, log_k - 3));
+  const int buckets = 1 << c;
+
+  std::vector<Ipp64u> xs(k * l);
+  std::vector<Ipp64u> bucket(buckets * l);
+  std::vector<char> used(buckets);
+
+  LimbArray<N> x, running, total;
+  for (std::size_t i = 0; i < k; i++) {
+    ctx.load(x.data(), base[i]);
+    ctx.mul<N>(xs.data() + i * l, x.data(), to_ctx);
+  }
+
+  bool started = false;
+  limb::copy<N>(r, ctx.one(), l);
+  for (int win = (bits + c - 1) / c - 1; win >= 0; win--) {
+    if (started)
+      for (int s = 0; s < c; s++) ctx.mul<N>(r, r, r);
+
+    std::fill(used.begin(), used.end(), 0);
+    for (std::size_t i = 0; i < k; i++) {
+      Ipp32u d = expDigit(exp[i], win * c, c);
+      if (!d) continue;
+      Ipp64u* b = bucket.data() + d * l;
+      if (used[d]) {
+        ctx.mul<N>(b, b, xs.data() + i * l);
+      } else {
+        limb::copy<N>(b, xs.data() + i * l, l);
+        used[d] = 1;
+      }
+    }
+
+    // total = prod(B_d^d) = prod over d of (B_top * ... * B_d)
+    bool has_running = false, has_total = false;
+    for (int d = buckets - 1; d > 0; d--) {
+      if (used[d]) {
+        const Ipp64u* b = bucket.data() + d * l;
+        if (has_running)
+          ctx.mul<N>(running.data(), running.data(), b);
+        else
+          limb::copy<N>(running.data(), b, l);
+        has_running = true;
+      }
+      if (!has_running) continue;
+      if (has_total)
+        ctx.mul<N>(total.data(), total.data(), running.data());
+      else
+        limb::copy<N>(total.data(), running.data(), l);
+      has_total = true;
+    }
+
+    if (!has_total) continue;
+    if (started) {
+      ctx.mul<N>(r, r, total.data());
+    } else {
+      limb::copy<N>(r, total.data(), l);
+      started = true;
+    }
+  }
+}
+
+// Window minimizing table construction plus row evaluation, bounded by
+// IPCL_MATVEC_TABLE_BYTES
+int matVecWindow(std::size_t cols, std::size_t nnz, int bits, int limbs) {
+  int best_w = 1;
+  double best_cost = std::numeric_limits<double>::max();
+  for (int w = 1; w <= 8; w++) {
+    std::size_t bytes = cols * (std::size_t(1) << w) * limbs * sizeof(Ipp64u);
+    if (w > 1 && bytes > IPCL_MATVEC_TABLE_BYTES) break;
+    double cost = static_cast<double>(cols) * ((1 << w) - 2) +
+                  static_cast<double>(nnz) * ((bits + w - 1) / w);
+    if (cost < best_cost) {
+      best_cost = cost;
+      best_w = w;
+    }
+  }
+  return best_w;
+}
+
+/**
+ * Shared implementation of the dense (col_idx == nullptr, entry e of a row
+ * belongs to column e) and CSR matrix-vector products
+ */
+std::vector<BigNumber> matVecExpImpl(const std::vector<BigNumber>& base,
+                                     std::size_t rows,
+                                     const std::vector<std::size_t>& row_ptr,
+                                     const std::size_t* col_idx,
+                                     const std::vector<BigNumber>& values,
+                                     const MontContext& ctx,
+                                     const MontDomain* dom) {
+  const std::size_t cols = base.size();
+  const std::size_t nnz = values.size();
+  const int l = ctx.getLimbs();
+  const MontDomain conv = domainOf(ctx, dom);
+
+  std::vector<ExpRef> exp_ref(nnz);
+  int max_bits = 1;
+  for (std::size_t i = 0; i < nnz; i++) {
+    IppsBigNumSGN sgn;
+    Ipp32u* data;
+    ippsRef_BN(&sgn, &exp_ref[i].bits, &data, BN(values[i]));
+    ERROR_CHECK(sgn == IppsBigNumPOS,
+                "matVecExp: negative exponent is not supported");
+    exp_ref[i].data = data;
+    exp_ref[i].words = BITSIZE_WORD(exp_ref[i].bits);
+    max_bits = std::max(max_bits, exp_ref[i].bits);
+  }
+
+  const int w = matVecWindow(cols, nnz, max_bits, l);
+  const int t_size = 1 << w;
+  std::vector<Ipp64u> table(cols * t_size * l);
+  auto entry = [&](std::size_t j, int d) {
+    return table.data() + (j * t_size + d) * l;
+  };
+
+#ifdef IPCL_USE_OMP
+  int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, cols))
+#endif  // IPCL_USE_OMP
+  for (std::size_t j = 0; j < cols; j++) {
+    dispatchLimbs(l, [&](auto L) {
+      constexpr int N = decltype(L)::value;
+      LimbArray<N> x;
+      ctx.load(x.data(), base[j]);
+      limb::copy<N>(entry(j, 0), ctx.one(), l);
+      ctx.mul<N>(entry(j, 1), x.data(), conv.to_ctx.data());
+      for (int d = 2; d < t_size; d++)
+        ctx.mul<N>(entry(j, d), entry(j, d - 1), entry(j, 1));
+    });
+  }
+
+  std::vector<BigNumber> res(rows);
+  const std::size_t blocks =
+      (rows + IPCL_MATVEC_ROW_BLOCK - 1) / IPCL_MATVEC_ROW_BLOCK;
+
+#ifdef IPCL_USE_OMP
+  omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, blocks))
+#endif  // IPCL_USE_OMP
+  for (std::size_t b = 0; b < blocks; b++) {
+    const std::size_t r0 = b * IPCL_MATVEC_ROW_BLOCK;
+    const std::size_t nr = std::min(IPCL_MATVEC_ROW_BLOCK, rows - r0);
+
+    dispatchLimbs(l, [&](auto L) {
+      constexpr int N = decltype(L)::value;
+      std::vector<Ipp64u> acc(nr * l);
+      std::vector<char> started(nr, 0);
+
+      auto mul_digit = [&](std::size_t r, std::size_t idx, std::size_t col,
+                           int win) {
+        Ipp32u d = expDigit(exp_ref[idx], win * w, w);
+        if (!d) return;
+        Ipp64u* a = acc.data() + r * l;
+        if (started[r]) {
+          ctx.mul<N>(a, a, entry(col, d));
+        } else {
+          limb::copy<N>(a, entry(col, d), l);
+          started[r] = 1;
+        }
+      };
+
+      for (int win = (max_bits + w - 1) / w - 1; win >= 0; win--) {
+        for (std::size_t r = 0; r < nr; r++) {
+          if (!started[r]) continue;
+          Ipp64u* a = acc.data() + r * l;
+          for (int s = 0; s < w; s++) ctx.mul<N>(a, a, a);
+        }
+
+        if (col_idx) {
+          for (std::size_t r = 0; r < nr; r++)
+            for (std::size_t idx = row_ptr[r0 + r]; idx < row_ptr[r0 + r + 1];
+                 idx++)
+              mul_digit(r, idx, col_idx[idx], win);
+        } else {
+          // Column outer loop, so a table is reused by the whole row block
+          // while it is in cache
+          for (std::size_t j = 0; j < cols; j++)
+            for (std::size_t r = 0; r < nr; r++)
+              mul_digit(r, row_ptr[r0 + r] + j, j, win);
+        }
+      }
+
+      for (std::size_t r = 0; r < nr; r++) {
+        Ipp64u* a = acc.data() + r * l;
+        if (!started[r]) limb::copy<N>(a, ctx.one(), l);
+        ctx.mul<N>(a, a, conv.from_ctx.data());
+        ctx.store(res[r0 + r], a);
+      }
+    });
+  }
+
+  return res;
+}
+
+}  // namespace
+
+std::vector<BigNumber> matVecExp(const std::vector<BigNumber>& base,
+                                 const DenseMatrix& mat, const MontContext& ctx,
+                                 const MontDomain* dom) {
+  ERROR_CHECK(mat.cols == base.size(), "matVecExp: column count mismatch");
+  ERROR_CHECK(mat.values.size() == mat.rows * mat.cols,
+              "matVecExp: dense matrix size mismatch");
+
+  std::vector<std::size_t> row_ptr(mat.rows + 1);
+  for (std::size_t r = 0; r <= mat.rows; r++) row_ptr[r] = r * mat.cols;
+  return matVecExpImpl(base, mat.rows, row_ptr, nullptr, mat.values, ctx,
+                       dom);
+}
+
+std::vector<BigNumber> matVecExp(const std::vector<BigNumber>& base,
+                                 const CSRMatrix& mat, const MontContext& ctx,
+                                 const MontDomain* dom) {
+  ERROR_CHECK(mat.cols == base.size(), "matVecExp: column count mismatch");
+  ERROR_CHECK(mat.row_ptr.size() == mat.rows + 1 && mat.row_ptr.front() == 0,
+              "matVecExp: CSR row pointer size mismatch");
+  ERROR_CHECK(mat.col_idx.size() == mat.values.size() &&
+                  mat.row_ptr.back() == mat.values.size(),
+              "matVecExp: CSR entry count mismatch");
+  for (std::size_t r = 0; r < mat.rows; r++)
+    ERROR_CHECK(mat.row_ptr[r] <= mat.row_ptr[r + 1],
+                "matVecExp: CSR row pointer is not sorted");
+  for (std::size_t col : mat.col_idx)
+    ERROR_CHECK(col < mat.cols, "matVecExp: CSR column index is out of range");
+
+  return matVecExpImpl(base, mat.rows, mat.row_ptr, mat.col_idx.data(),
+                       mat.values, ctx, dom);
+}
+
+BigNumber multiExp(const std::vector<BigNumber>& base,
+                   const std::vector<BigNumber>& exp, const MontContext& ctx,
+                   const MontDomain* dom) {
+  std::size_t v_size = base.size();
+  ERROR_CHECK(v_size > 0, "multiExp: Cannot exponentiate empty vector");
+  ERROR_CHECK(exp.size() == v_size, "multiExp: input vector size mismatch");
+
+  std::vector<ExpRef> exp_ref(v_size);
+  int max_bits = 1;
+  for (std::size_t i = 0; i < v_size; i++) {
+    IppsBigNumSGN sgn;
+    Ipp32u* data;
+    ippsRef_BN(&sgn, &exp_ref[i].bits, &data, BN(exp[i]));
+    ERROR_CHECK(sgn == IppsBigNumPOS,
+                "multiExp: negative exponent is not supported");
+    exp_ref[i].data = data;
+    exp_ref[i].words = BITSIZE_WORD(exp_ref[i].bits);
+    max_bits = std::max(max_bits, exp_ref[i].bits);
+  }
+
+  // One block per thread, but keep enough bases per block to share the
+  // squarings
+  const int l = ctx.getLimbs();
+  const MontDomain conv = domainOf(ctx, dom);
+  std::size_t blocks = 1;
+#ifdef IPCL_USE_OMP
+  blocks = std::max<std::size_t>(
+      1, std::min<std::size_t>(OMPUtilities::MaxThreads,
+                               v_size / IPCL_MULTI_EXP_STRAUS_THRESHOLD));
+#endif  // IPCL_USE_OMP
+  std::size_t block_size = (v_size + blocks - 1) / blocks;
+  blocks = (v_size + block_size - 1) / block_size;
+
+  std::vector<Ipp64u> partial(blocks * l);
+#ifdef IPCL_USE_OMP
+  int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, blocks))
+#endif  // IPCL_USE_OMP
+  for (std::size_t b = 0; b < blocks; b++) {
+    std::size_t begin = b * block_size;
+    std::size_t k = std::min(block_size, v_size - begin);
+    dispatchLimbs(l, [&](auto L) {
+      constexpr int N = decltype(L)::value;
+      if (k < IPCL_MULTI_EXP_STRAUS_THRESHOLD)
+        strausBlock<N>(partial.data() + b * l, ctx, conv.to_ctx.data(),
+                       base.data() + begin, exp_ref.data() + begin, k,
+                       max_bits);
+      else
+        pippengerBlock<N>(partial.data() + b * l, ctx, conv.to_ctx.data(),
+                          base.data() + begin, exp_ref.data() + begin, k,
+                          max_bits);
+    });
+  }
+
+  BigNumber res;
+  dispatchLimbs(l, [&](auto L) {
+    constexpr int N = decltype(L)::value;
+    LimbArray<N> acc;
+    limb::copy<N>(acc.data(), partial.data(), l);
+    for (std::size_t b = 1; b < blocks; b++)
+      ctx.mul<N>(acc.data(), acc.data(), partial.data() + b * l);
+    ctx.mul<N>(acc.data(), acc.data(), conv.from_ctx.data());
+    ctx.store(res, acc.data());
+  });
+  return res;
+}
+
+}  // namespace ipcl
@@ -0,0 +1,238 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ipcl/packing.hpp"
+
+#include <algorithm>
+
+#include "ipcl/utils/util.hpp"
+
+namespace ipcl {
+
+namespace {
+
+// dst |= src << pos, dst must hold pos + 32 * src_words bits and one spare
+// word
+void depositBits(Ipp32u* dst, int pos, const Ipp32u* src, int src_words) {
+  const int shift = pos & 31;
+  Ipp32u* d = dst + (pos >> 5);
+  for (int t = 0; t < src_words; t++) {
+    d[t] |= src[t] << shift;
+    if (shift) d[t + 1] |= src[t] >> (32 - shift);
+  }
+}
+
+// dst = bits [pos, pos + bits) of src, src must hold one spare word past
+// the last bit read
+void extractBits(Ipp32u* dst, const Ipp32u* src, int pos, int bits) {
+  const int shift = pos & 31;
+  const Ipp32u* s = src + (pos >> 5);
+  const int words = BITSIZE_WORD(bits);
+  for (int t = 0; t < words; t++)
+    dst[t] = shift ? (s[t] >> shift) | (s[t + 1] << (32 - shift)) : s[t];
+  if (bits & 31) dst[words - 1] &= (Ipp32u(1) << (bits & 31)) - 1;
+}
+
+BigNumber powerOfTwo(int e) {
+  std::vector<Ipp32u> words((e >> 5) + 1, 0);
+  words.back() = Ipp32u(1) << (e & 31);
+  return BigNumber(words.data(), words.size());
+}
+
+// prod(c[i]^(2^(width * i))) mod m for i < k by Horner's rule, the running
+// product is squared width times before every next factor
+BigNumber shiftCombine(const BigNumber* c, std::size_t k, int width,
+                       const MontContext& ctx) {
+  BigNumber r;
+  dispatchLimbs(ctx.getLimbs(), [&](auto L) {
+    constexpr int N = decltype(L)::value;
+    LimbArray<N> acc, x;
+    ctx.load(x.data(), c[k - 1]);
+    ctx.toMont<N>(acc.data(), x.data());
+    for (std::size_t i = k - 1; i-- > 0;) {
+      for (int s = 0; s < width; s++)
+        ctx.mul<N>(acc.data(), acc.data(), acc.data());
+      ctx.load(x.data(), c[i]);
+      ctx.toMont<N>(x.data(), x.data());
+      ctx.mul<N>(acc.data(), acc.data(), x.data());
+    }
+    ctx.fromMont<N>(acc.data(), acc.data());
+    ctx.store(r, acc.data());
+  });
+  return r;
+}
+
+}  // namespace
+
+SlotPacker::SlotPacker(const PublicKey& pk, int slot_bits, int headroom_bits)
+    : m_slot_bits(slot_bits), m_headroom_bits(headroom_bits) {
+  ERROR_CHECK(slot_bits > 0 && headroom_bits >= 0,
+              "SlotPacker: invalid slot layout");
+  ERROR_CHECK(getSlotWidth() < pk.getBits(),
+              "SlotPacker: slot is wider than the plaintext space");
+  m_slots = (pk.getBits() - 1) / getSlotWidth();
+}
+
+PlainText SlotPacker::pack(const std::vector<BigNumber>& values) const {
+  ERROR_CHECK(m_slots > 0, "SlotPacker: uninitialized packer");
+  ERROR_CHECK(!values.empty(), "SlotPacker: nothing to pack");
+
+  for (const BigNumber& v : values) {
+    IppsBigNumSGN sgn;
+    int bits;
+    ippsRef_BN(&sgn, &bits, nullptr, BN(v));
+    ERROR_CHECK(sgn == IppsBigNumPOS && bits <= m_slot_bits,
+                "SlotPacker: value does not fit in a slot");
+  }
+
+  const std::size_t count = values.size();
+  const std::size_t packed_size = getPackedSize(count);
+  const int width = getSlotWidth();
+  const int words = BITSIZE_WORD(static_cast<int>(m_slots) * width) + 1;
+  std::vector<BigNumber> packed(packed_size);
+
+#ifdef IPCL_USE_OMP
+  int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, packed_size))
+#endif  // IPCL_USE_OMP
+  for (std::size_t j = 0; j < packed_size; j++) {
+    std::vector<Ipp32u> buf(words, 0);
+    const std::size_t first = j * m_slots;
+    const std::size_t last = std::min(count, first + m_slots);
+    for (std::size_t i = first; i < last; i++) {
+      int bits;
+      Ipp32u* data;
+      ippsRef_BN(nullptr, &bits, &data, BN(values[i]));
+      depositBits(buf.data(), static_cast<int>(i - first) * width, data,
+                  BITSIZE_WORD(bits));
+    }
+    packed[j] = BigNumber(buf.data(), words);
+  }
+  return PlainText(packed);
+}
+
+PlainText SlotPacker::pack(const std::vector<uint32_t>& values) const {
+  return pack(std::vector<BigNumber>(values.begin(), values.end()));
+}
+
+std::vector<BigNumber> SlotPacker::unpack(const PlainText& pt,
+                                          std::size_t count) const {
+  ERROR_CHECK(m_slots > 0, "SlotPacker: uninitialized packer");
+  ERROR_CHECK(count <= pt.getSize() * m_slots,
+              "SlotPacker: PlainText holds fewer slots than requested");
+
+  const std::vector<BigNumber>& texts = pt.getTexts();
+  const std::size_t packed_size = getPackedSize(count);
+  const int width = getSlotWidth();
+  const int packed_bits = static_cast<int>(m_slots) * width;
+  const int words = BITSIZE_WORD(packed_bits) + 1;
+  std::vector<BigNumber> values(count);
+  std::vector<char> in_range(packed_size, 1);
+
+#ifdef IPCL_USE_OMP
+  int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, packed_size))
+#endif  // IPCL_USE_OMP
+  for (std::size_t j = 0; j < packed_size; j++) {
+    IppsBigNumSGN sgn;
+    int bits;
+    Ipp32u* data;
+    ippsRef_BN(&sgn, &bits, &data, BN(texts[j]));
+    if (sgn != IppsBigNumPOS || bits > packed_bits) {
+      in_range[j] = 0;
+      continue;
+    }
+
+    std::vector<Ipp32u> buf(words, 0), slot(BITSIZE_WORD(width));
+    std::copy(data, data + BITSIZE_WORD(bits), buf.begin());
+    const std::size_t first = j * m_slots;
+    const std::size_t last = std::min(count, first + m_slots);
+    for (std::size_t i = first; i < last; i++) {
+      extractBits(slot.data(), buf.data(), static_cast<int>(i - first) * width,
+                  width);
+      values[i] = BigNumber(slot.data(), slot.size());
+    }
+  }
+  ERROR_CHECK(std::all_of(in_range.begin(), in_range.end(),
+                          [](char c) { return c != 0; }),
+              "SlotPacker: packed value exceeds the slot layout");
+  return values;
+}
+
+PackedCipherText::PackedCipherText(const PublicKey& pk,
+                                   const SlotPacker& packer,
+                                   const std::vector<BigNumber>& values)
+    : m_packer(packer),
+      m_ct(pk.encrypt(packer.pack(values))),
+      m_count(values.size()),
+      m_bound(powerOfTwo(packer.getSlotBits()) - 1) {}
+
+PackedCipherText::PackedCipherText(const SlotPacker& packer,
+                                   const CipherText& ct, std::size_t count,
+                                   const BigNumber& bound)
+    : m_packer(packer), m_ct(ct), m_count(count), m_bound(bound) {
+  ERROR_CHECK(ct.getSize() == packer.getPackedSize(count),
+              "PackedCipherText: CipherText size does not match the count");
+  ERROR_CHECK(bound.BitSize() <= packer.getSlotWidth(),
+              "PackedCipherText: bound exceeds the slot width");
+}
+
+PackedCipherText PackedCipherText::compact(const SlotPacker& packer,
+                                           const CipherText& ct,
+                                           const BigNumber& bound) {
+  ERROR_CHECK(packer.getSlotCount() > 0, "SlotPacker: uninitialized packer");
+  ERROR_CHECK(ct.getSize() > 0, "PackedCipherText: empty CipherText");
+
+  const std::vector<BigNumber> texts = ct.getTexts();
+  const std::size_t count = texts.size();
+  const std::size_t slots = packer.getSlotCount();
+  const std::size_t packed_size = packer.getPackedSize(count);
+  const MontContext& ctx = *(ct.getPubKey()->getNSQMont());
+  std::vector<BigNumber> packed(packed_size);
+
+#ifdef IPCL_USE_OMP
+  int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, packed_size))
+#endif  // IPCL_USE_OMP
+  for (std::size_t j = 0; j < packed_size; j++) {
+    const std::size_t first = j * slots;
+    packed[j] = shiftCombine(texts.data() + first,
+                             std::min(slots, count - first),
+                             packer.getSlotWidth(), ctx);
+  }
+
+  return PackedCipherText(packer, CipherText(*(ct.getPubKey()), packed),
+                          count, bound);
+}
+
+PackedCipherText PackedCipherText::operator+(
+    const PackedCipherText& other) const {
+  ERROR_CHECK(m_packer == other.m_packer && m_count == other.m_count,
+              "PackedCipherText: slot layout mismatch");
+  BigNumber bound = m_bound + other.m_bound;
+  ERROR_CHECK(bound.BitSize() <= m_packer.getSlotWidth(),
+              "PackedCipherText: sum would overflow the slot headroom");
+  return PackedCipherText(m_packer, m_ct + other.m_ct, m_count, bound);
+}
+
+PackedCipherText PackedCipherText::operator*(const BigNumber& scalar) const {
+  ERROR_CHECK(scalar >= BigNumber::Zero(),
+              "PackedCipherText: negative scalar is not supported");
+  BigNumber bound = m_bound * scalar;
+  ERROR_CHECK(bound.BitSize() <= m_packer.getSlotWidth(),
+              "PackedCipherText: product would overflow the slot headroom");
+  return PackedCipherText(m_packer, m_ct * PlainText(scalar), m_count, bound);
+}
+
+std::vector<BigNumber> PackedCipherText::decrypt(const PrivateKey& sk) const {
+  return m_packer.unpack(sk.decrypt(m_ct), m_count);
+}
+
+int PackedCipherText::getHeadroom() const {
+  return m_packer.getSlotWidth() - m_bound.BitSize();
+}
+
+}  // namespace ipcl
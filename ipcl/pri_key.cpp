@@ -3,6 +3,8 @@
 
 #include "ipcl/pri_key.hpp"
 
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
 
 #include "crypto_mb/exp.h"
@@ -22,6 +24,119 @@ static inline BigNumber lcm(const BigNumber& p, const BigNumber& q) {
   return p * q / gcd;
 }
 
+/**
+ * Copy a non-negative BigNumber into limbs zero limbs wide
+ * @return false, leaving r untouched, if the value does not fit
+ */
+static inline bool toLimbs(Ipp64u* r, int limbs, const BigNumber& bn) {
+  int bits;
+  Ipp32u* data;
+  ippsRef_BN(nullptr, &bits, &data, BN(bn));
+  if (BITSIZE_DWORD(bits) > limbs) return false;
+
+  std::memset(r, 0, limbs * sizeof(Ipp64u));
+  std::memcpy(r, data, BITSIZE_WORD(bits) * sizeof(Ipp32u));
+  return true;
+}
+
+/**
+ * Copy the low limbs limbs of a non-negative BigNumber, zero padded
+ */
+static inline void lowLimbs(Ipp64u* r, int limbs, const BigNumber& bn) {
+  int bits;
+  Ipp32u* data;
+  ippsRef_BN(nullptr, &bits, &data, BN(bn));
+
+  std::memset(r, 0, limbs * sizeof(Ipp64u));
+  std::memcpy(r, data,
+              std::min(BITSIZE_WORD(bits), 2 * limbs) * sizeof(Ipp32u));
+}
+
+/**
+ * out = L(x) * h mod d where L(x) = (x - 1) / d is computed by exact
+ * division, only the low limbs of x matter. div and ctx belong to d.
+ */
+static inline void lfunMul(BigNumber& out, const Ipp64u* x,
+                           const ExactDivisor& div, const MontContext& ctx,
+                           const BigNumber& h) {
+  const int l = ctx.getLimbs();
+  dispatchLimbs(l, [&](auto L) {
+    constexpr int N = decltype(L)::value;
+    LimbArray<N> t, y;
+    limb::copy<N>(t.data(), x, l);
+    for (int j = 0; j < l; j++)
+      if (t[j]-- != 0) break;
+    div.divide<N>(t.data(), t.data());
+    ctx.load(y.data(), h);
+    ctx.modMul<N>(t.data(), t.data(), y.data());
+    ctx.store(out, t.data());
+  });
+}
+
+/**
+ * r = c mod m by Montgomery reduction of the double width c, ciphertexts of
+ * unusual width fall back to the division
+ */
+static inline void reduceInto(Ipp64u* r, const BigNumber& c,
+                              const MontContext& ctx) {
+  const int l = ctx.getLimbs();
+  dispatchLimbs(l, [&](auto L) {
+    constexpr int N = decltype(L)::value;
+    Ipp64u x[2 * limb::len<N>(IPCL_MAX_LIMBS)];
+    if (toLimbs(x, 2 * l, c))
+      ctx.reduce<N>(r, x);
+    else
+      ctx.load(r, c);
+  });
+}
+
+/**
+ * v = x for a non-negative x of at most 64 bits
+ */
+static inline bool toUint64(uint64_t& v, const BigNumber& x) {
+  int bits;
+  Ipp32u* data;
+  ippsRef_BN(nullptr, &bits, &data, BN(x));
+  if (bits > 64) return false;
+
+  v = data[0];
+  if (bits > 32) v |= static_cast<uint64_t>(data[1]) << 32;
+  return true;
+}
+
+/**
+ * v = -mag, false if mag exceeds 2^63. Unsigned values are never negative.
+ */
+static inline bool fromNegative(int64_t& v, const BigNumber& mag) {
+  uint64_t t;
+  if (!toUint64(t, mag) || t > (uint64_t(1) << 63)) return false;
+  v = static_cast<int64_t>(~t + 1);
+  return true;
+}
+
+static inline bool fromNegative(uint64_t&, const BigNumber&) {
+  return false;
+}
+
+/**
+ * Native value of a plaintext m < n, negative values are encoded as n - |m|
+ * @return false if the value does not fit in T
+ */
+static inline bool toNative(uint64_t& v, const BigNumber& m,
+                            const BigNumber&) {
+  return toUint64(v, m);
+}
+
+static inline bool toNative(int64_t& v, const BigNumber& m,
+                            const BigNumber& n) {
+  uint64_t t;
+  if (toUint64(t, m) && t <= static_cast<uint64_t>(INT64_MAX)) {
+    v = static_cast<int64_t>(t);
+    return true;
+  }
+  return fromNegative(v, n - m);
+}
+
 PrivateKey::PrivateKey(const PublicKey& pk, const BigNumber& p,
                        const BigNumber& q)
     : m_n(pk.getN()),
@@ -41,7 +156,22 @@ PrivateKey::PrivateKey(const PublicKey& pk, const BigNumber& p,
       m_hq(computeHfun(*m_q, m_qsquare)),
       m_lambda(lcm(m_pminusone, m_qminusone)),
       m_x((*m_n).InverseMul((modExp(*m_g, m_lambda, *m_nsquare) - 1) /
-                            (*m_n))) {
+                            (*m_n))),
+      m_n_phip((*m_q % m_pminusone) * (*m_p)),
+      m_n_phiq((*m_p % m_qminusone) * (*m_q)),
+      m_psqinverse(m_qsquare.InverseMul(m_psquare)),
+      m_p_mont(std::make_shared<MontContext>(*m_p)),
+      m_q_mont(std::make_shared<MontContext>(*m_q)),
+      m_psq_mont(std::make_shared<MontContext>(m_psquare)),
+      m_qsq_mont(std::make_shared<MontContext>(m_qsquare)),
+      m_n_mont(std::make_shared<MontContext>(*m_n)),
+      m_psq_reducer(std::make_shared<ModReducer>(
+          m_psquare, ModReducer::Method::Barrett)),
+      m_qsq_reducer(std::make_shared<ModReducer>(
+          m_qsquare, ModReducer::Method::Barrett)),
+      m_p_div(std::make_shared<ExactDivisor>(*m_p)),
+      m_q_div(std::make_shared<ExactDivisor>(*m_q)),
+      m_n_div(std::make_shared<ExactDivisor>(*m_n)) {
   ERROR_CHECK((*m_p) * (*m_q) == *m_n,
               "PrivateKey ctor: Public key does not match p * q.");
   ERROR_CHECK(*m_p != *m_q, "PrivateKey ctor: p and q are same");
@@ -67,7 +197,22 @@ PrivateKey::PrivateKey(const BigNumber& n, const BigNumber& p,
       m_hq(computeHfun(*m_q, m_qsquare)),
       m_lambda(lcm(m_pminusone, m_qminusone)),
       m_x((*m_n).InverseMul((modExp(*m_g, m_lambda, *m_nsquare) - 1) /
-                            (*m_n))) {
+                            (*m_n))),
+      m_n_phip((*m_q % m_pminusone) * (*m_p)),
+      m_n_phiq((*m_p % m_qminusone) * (*m_q)),
+      m_psqinverse(m_qsquare.InverseMul(m_psquare)),
+      m_p_mont(std::make_shared<MontContext>(*m_p)),
+      m_q_mont(std::make_shared<MontContext>(*m_q)),
+      m_psq_mont(std::make_shared<MontContext>(m_psquare)),
+      m_qsq_mont(std::make_shared<MontContext>(m_qsquare)),
+      m_n_mont(std::make_shared<MontContext>(*m_n)),
+      m_psq_reducer(std::make_shared<ModReducer>(
+          m_psquare, ModReducer::Method::Barrett)),
+      m_qsq_reducer(std::make_shared<ModReducer>(
+          m_qsquare, ModReducer::Method::Barrett)),
+      m_p_div(std::make_shared<ExactDivisor>(*m_p)),
+      m_q_div(std::make_shared<ExactDivisor>(*m_q)),
+      m_n_div(std::make_shared<ExactDivisor>(*m_n)) {
   ERROR_CHECK((*m_p) * (*m_q) == *m_n,
               "PrivateKey ctor: Public key does not match p * q.");
   ERROR_CHECK(*m_p != *m_q, "PrivateKey ctor: p and q are same");
@@ -129,6 +274,158 @@ void PrivateKey::decrypt2(const CipherText& ct, void** destination) const {
   *destination = plaintext;
 }
 
+void PrivateKey::decrypt_to(const CipherText& ct, uint64_t* out,
+                            std::size_t size) const {
+  decryptTo(ct, out, size);
+}
+
+void PrivateKey::decrypt_to(const CipherText& ct, int64_t* out,
+                            std::size_t size) const {
+  decryptTo(ct, out, size);
+}
+
+template <typename T>
+void PrivateKey::decryptTo(const CipherText& ct, T* out,
+                           std::size_t size) const {
+  ERROR_CHECK(m_isInitialized, "decrypt_to: Private key is NOT initialized.");
+  ERROR_CHECK(*(ct.getPubKey()->getN()) == *(this->getN()),
+              "decrypt_to: The value of N in public key mismatch.");
+
+  std::size_t ct_size = ct.getSize();
+  ERROR_CHECK(ct_size > 0, "decrypt_to: Cannot decrypt empty CipherText");
+  ERROR_CHECK(size == ct_size, "decrypt_to: Output size mismatch");
+
+  // If hybrid OPTIMAL mode is used, use a special ratio
+  if (isHybridOptimal()) {
+    float qat_ratio = (ct_size <= IPCL_WORKLOAD_SIZE_THRESHOLD)
+                          ? IPCL_HYBRID_MODEXP_RATIO_FULL
+                          : IPCL_HYBRID_MODEXP_RATIO_DECRYPT;
+    setHybridRatio(qat_ratio, false);
+  }
+
+#ifndef IPCL_USE_QAT
+  if (m_enable_crt) {
+    // m = mp + u * p is below 2^64 only for u == 0 and n - m only for
+    // u == q - 1, where n - m = p - mp. Other values need the full m to be
+    // range checked.
+    std::size_t num_chunk =
+        (ct_size + IPCL_CRT_CHUNK_SIZE - 1) / IPCL_CRT_CHUNK_SIZE;
+    std::vector<char> in_range(num_chunk, 1);
+
+#ifdef IPCL_USE_OMP
+    int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, num_chunk))
+#endif  // IPCL_USE_OMP
+    for (std::size_t i = 0; i < num_chunk; i++) {
+      std::size_t offset = i * IPCL_CRT_CHUNK_SIZE;
+      int k = static_cast<int>(
+          std::min<std::size_t>(IPCL_CRT_CHUNK_SIZE, ct_size - offset));
+      std::vector<BigNumber> ct_bn = ct.getChunk(offset, k);
+      BigNumber mp[IPCL_CRT_CHUNK_SIZE], u[IPCL_CRT_CHUNK_SIZE];
+      decryptCRTChunk(mp, u, ct_bn.data(), k);
+
+      for (int j = 0; j < k; j++) {
+        T& v = out[offset + j];
+        bool ok;
+        if (u[j] == BigNumber::Zero())
+          ok = toNative(v, mp[j], *m_n);
+        else
+          ok = (u[j] == m_qminusone && fromNegative(v, *m_p - mp[j])) ||
+               toNative(v, mp[j] + u[j] * (*m_p), *m_n);
+        if (!ok) in_range[i] = 0;
+      }
+    }
+
+    ERROR_CHECK(std::all_of(in_range.begin(), in_range.end(),
+                            [](char c) { return c != 0; }),
+                "decrypt_to: plaintext out of range");
+    return;
+  }
+#endif  // IPCL_USE_QAT
+
+  // QAT batches and raw decryption go through BigNumber plaintexts
+  std::vector<BigNumber> pt_bn(ct_size);
+  std::vector<BigNumber> ct_bn = ct.getTexts();
+  if (m_enable_crt)
+    decryptCRT(pt_bn, ct_bn);
+  else
+    decryptRAW(pt_bn, ct_bn);
+
+  for (std::size_t i = 0; i < ct_size; i++)
+    ERROR_CHECK(toNative(out[i], pt_bn[i], *m_n),
+                "decrypt_to: plaintext out of range");
+}
+
+CipherText PrivateKey::encrypt(const PublicKey& pk, const PlainText& pt,
+                               bool make_secure) const {
+  ERROR_CHECK(m_isInitialized, "encrypt: Private key is NOT initialized.");
+  ERROR_CHECK(*(pk.getN()) == *m_n,
+              "encrypt: The value of N in public key mismatch.");
+
+  std::size_t pt_size = pt.getSize();
+  ERROR_CHECK(pt_size > 0, "encrypt: Cannot encrypt empty PlainText");
+
+  std::vector<BigNumber> ct;
+  pk.powG(ct, pt.getTexts());
+  if (!make_secure) return CipherText(pk, ct);
+
+  std::vector<BigNumber> r = pk.getObfuscatorRandom(pt_size);
+  ERROR_CHECK(r.size() == pt_size, "encrypt: random value size mismatch");
+
+  // DJN obfuscators share the base hs
+  BigNumber hs[2];
+  if (pk.isDJN()) {
+    hs[0] = m_psq_reducer->reduce(pk.getHS());
+    hs[1] = m_qsq_reducer->reduce(pk.getHS());
+  }
+
+  std::vector<BigNumber> obf(pt_size);
+  std::size_t num_chunk =
+      (pt_size + IPCL_CRT_CHUNK_SIZE - 1) / IPCL_CRT_CHUNK_SIZE;
+
+#ifdef IPCL_USE_OMP
+  int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, num_chunk))
+#endif  // IPCL_USE_OMP
+  for (std::size_t i = 0; i < num_chunk; i++) {
+    std::size_t offset = i * IPCL_CRT_CHUNK_SIZE;
+    int k = static_cast<int>(
+        std::min<std::size_t>(IPCL_CRT_CHUNK_SIZE, pt_size - offset));
+    obfuscatorCRTChunk(obf.data() + offset, r.data() + offset, k,
+                       pk.isDJN() ? hs : nullptr);
+  }
+
+  pk.getNSQMulEngine()->modMul(ct, ct, obf);
+  return CipherText(pk, ct);
+}
+
+void PrivateKey::decryptStream(const BigNumberSource& source,
+                               const BigNumberSink& sink,
+                               std::size_t chunk_size) const {
+  ERROR_CHECK(m_isInitialized,
+              "decryptStream: Private key is NOT initialized.");
+
+  // If hybrid OPTIMAL mode is used, use a special ratio
+  if (isHybridOptimal()) {
+    float qat_ratio = (chunk_size <= IPCL_WORKLOAD_SIZE_THRESHOLD)
+                          ? IPCL_HYBRID_MODEXP_RATIO_FULL
+                          : IPCL_HYBRID_MODEXP_RATIO_DECRYPT;
+    setHybridRatio(qat_ratio, false);
+  }
+
+  auto stage = [this](std::vector<BigNumber>& pt,
+                      const std::vector<BigNumber>& ct) {
+    pt.resize(ct.size());
+    if (m_enable_crt)
+      decryptCRT(pt, ct);
+    else
+      decryptRAW(pt, ct);
+  };
+  runPipeline(source, stage, sink, chunk_size);
+}
+
 void PrivateKey::decryptRAW(std::vector<BigNumber>& plaintext,
                             const std::vector<BigNumber>& ciphertext) const {
   std::size_t v_size = plaintext.size();
@@ -143,10 +440,10 @@ void PrivateKey::decryptRAW(std::vector<BigNumber>& plaintext,
     OMPUtilities::assignOMPThreads(omp_remaining_threads, v_size))
 #endif  // IPCL_USE_OMP
   for (int i = 0; i < v_size; i++) {
-    BigNumber nn = *m_n;
-    BigNumber xx = m_x;
-    BigNumber m = ((res[i] - 1) / nn) * xx;
-    plaintext[i] = m % nn;
+    // m = L(res) * x mod n, L by exact division
+    Ipp64u low[IPCL_MAX_LIMBS];
+    lowLimbs(low, m_n_div->getLimbs(), res[i]);
+    lfunMul(plaintext[i], low, *m_n_div, *m_n_mont, m_x);
   }
 }
 
@@ -155,40 +452,203 @@ void PrivateKey::decryptCRT(std::vector<BigNumber>& plaintext,
                             const std::vector<BigNumber>& ciphertext) const {
   std::size_t v_size = plaintext.size();
 
-  std::vector<BigNumber> basep(v_size), baseq(v_size);
+#ifdef IPCL_USE_QAT
+  // QAT and hybrid mode take whole batches of BigNumber
+  std::vector<BigNumber> basep, baseq;
   std::vector<BigNumber> pm1(v_size, m_pminusone), qm1(v_size, m_qminusone);
   std::vector<BigNumber> psq(v_size, m_psquare), qsq(v_size, m_qsquare);
 
+  // Based on the fact a^b mod n = (a mod n)^b mod n. Both halves go out as
+  // one job of independent requests with mixed moduli.
+  m_psq_reducer->reduce(basep, ciphertext);
+  m_qsq_reducer->reduce(baseq, ciphertext);
+  basep.insert(basep.end(), baseq.begin(), baseq.end());
+  pm1.insert(pm1.end(), qm1.begin(), qm1.end());
+  psq.insert(psq.end(), qsq.begin(), qsq.end());
+  std::vector<BigNumber> resp = modExp(basep, pm1, psq);
+
+  const int words = m_nsquare->DwordSize();
 #ifdef IPCL_USE_OMP
   int omp_remaining_threads = OMPUtilities::MaxThreads;
-#pragma omp parallel for num_threads( \
+#pragma omp parallel num_threads( \
     OMPUtilities::assignOMPThreads(omp_remaining_threads, v_size))
 #endif  // IPCL_USE_OMP
-  for (int i = 0; i < v_size; i++) {
-    basep[i] = ciphertext[i] % psq[i];
-    baseq[i] = ciphertext[i] % qsq[i];
+  {
+    // Presized scratch, one set per thread reused for all its elements
+    BigNumber t(0, words), l(0, words), r(0, words);
+    BigNumber dp(0, words), dq(0, words);
+    Ipp64u low[IPCL_MAX_LIMBS];
+
+#ifdef IPCL_USE_OMP
+#pragma omp for
+#endif  // IPCL_USE_OMP
+    for (std::size_t i = 0; i < v_size; i++) {
+      // dp = L(resp) * hp mod p, dq = L(resq) * hq mod q and
+      // m = dp + ((dq - dp) * p^(-1) mod q) * p, with dp < p < q
+      lowLimbs(low, m_p_div->getLimbs(), resp[i]);
+      lfunMul(dp, low, *m_p_div, *m_p_mont, m_hp);
+      lowLimbs(low, m_q_div->getLimbs(), resp[v_size + i]);
+      lfunMul(dq, low, *m_q_div, *m_q_mont, m_hq);
+
+      sub_into(t, *m_q, dp);
+      addmod_into(r, dq, t, *m_q_mont);
+      mulmod_into(r, r, m_pinverse, *m_q_mont);
+      mul_into(l, r, *m_p);
+      add_into(plaintext[i], dp, l);
+    }
   }
+#else
+  // One fused pipeline per chunk, the p and q halves of a chunk share the
+  // lanes of one multi-buffer exponentiation
+  std::size_t num_chunk =
+      (v_size + IPCL_CRT_CHUNK_SIZE - 1) / IPCL_CRT_CHUNK_SIZE;
 
-  // Based on the fact a^b mod n = (a mod n)^b mod n
-  std::vector<BigNumber> resp = modExp(basep, pm1, psq);
-  std::vector<BigNumber> resq = modExp(baseq, qm1, qsq);
+#ifdef IPCL_USE_OMP
+  int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, num_chunk))
+#endif  // IPCL_USE_OMP
+  {
+    // Chunk results and scratch, one set per thread reused for all chunks
+    BigNumber mp[IPCL_CRT_CHUNK_SIZE], u[IPCL_CRT_CHUNK_SIZE];
+    BigNumber t(0, m_nsquare->DwordSize());
 
 #ifdef IPCL_USE_OMP
-  omp_remaining_threads = OMPUtilities::MaxThreads;
-#pragma omp parallel for num_threads( \
-    OMPUtilities::assignOMPThreads(omp_remaining_threads, v_size))
+#pragma omp for
 #endif  // IPCL_USE_OMP
-  for (int i = 0; i < v_size; i++) {
-    BigNumber dp = computeLfun(resp[i], *m_p) * m_hp % (*m_p);
-    BigNumber dq = computeLfun(resq[i], *m_q) * m_hq % (*m_q);
-    plaintext[i] = computeCRT(dp, dq);
+    for (std::size_t i = 0; i < num_chunk; i++) {
+      std::size_t offset = i * IPCL_CRT_CHUNK_SIZE;
+      int k = static_cast<int>(
+          std::min<std::size_t>(IPCL_CRT_CHUNK_SIZE, v_size - offset));
+      decryptCRTChunk(mp, u, ciphertext.data() + offset, k);
+
+      // m = mp + u * p
+      for (int j = 0; j < k; j++) {
+        mul_into(t, u[j], *m_p);
+        add_into(plaintext[offset + j], mp[j], t);
+      }
+    }
   }
+#endif  // IPCL_USE_QAT
 }
 
-BigNumber PrivateKey::computeCRT(const BigNumber& mp,
-                                 const BigNumber& mq) const {
-  BigNumber u = (mq - mp) * m_pinverse % (*m_q);
-  return mp + (u * (*m_p));
+void PrivateKey::decryptCRTChunk(BigNumber* mp, BigNumber* u,
+                                 const BigNumber* ciphertext, int k) const {
+  const MontContext& psq = *m_psq_mont;
+  const MontContext& qsq = *m_qsq_mont;
+  const int w = std::max(psq.getLimbs(), qsq.getLimbs());
+  const int mod_bits = std::max(m_psquare.BitSize(), m_qsquare.BitSize());
+
+  // Lanes of w limbs, p halves in lanes [0, k) and q halves in [k, 2k),
+  // followed by the exponents and moduli
+  std::vector<Ipp64u> buff((2 * IPCL_CRYPTO_MB_SIZE + 4) * w, 0);
+  auto base = [&](int i) { return buff.data() + i * w; };
+  auto res = [&](int i) {
+    return buff.data() + (IPCL_CRYPTO_MB_SIZE + i) * w;
+  };
+  Ipp64u* pm1 = res(IPCL_CRYPTO_MB_SIZE);
+  Ipp64u* qm1 = pm1 + w;
+  Ipp64u* psq_l = qm1 + w;
+  Ipp64u* qsq_l = psq_l + w;
+  toLimbs(pm1, w, m_pminusone);
+  toLimbs(qm1, w, m_qminusone);
+  toLimbs(psq_l, w, m_psquare);
+  toLimbs(qsq_l, w, m_qsquare);
+
+  // Based on the fact a^b mod n = (a mod n)^b mod n
+  Ipp64u* out[IPCL_CRYPTO_MB_SIZE];
+  const Ipp64u* in[IPCL_CRYPTO_MB_SIZE];
+  const Ipp64u* exp[IPCL_CRYPTO_MB_SIZE];
+  const Ipp64u* mod[IPCL_CRYPTO_MB_SIZE];
+  for (int i = 0; i < 2 * k; i++) {
+    bool q_half = i >= k;
+    reduceInto(base(i), ciphertext[q_half ? i - k : i], q_half ? qsq : psq);
+    out[i] = res(i);
+    in[i] = base(i);
+    exp[i] = q_half ? qm1 : pm1;
+    mod[i] = q_half ? qsq_l : psq_l;
+  }
+  int exp_bits = std::max(m_pminusone.BitSize(), m_qminusone.BitSize());
+  modExpLanes(out, in, exp, exp_bits, mod, mod_bits, 2 * k);
+
+  // mp = L(resp) * hp mod p, mq = L(resq) * hq mod q and
+  // u = (mq - mp) * p^(-1) mod q, with mp < p < q
+  const int words = m_nsquare->DwordSize();
+  BigNumber t(0, words), r(0, words), mq(0, words);
+  for (int i = 0; i < k; i++) {
+    lfunMul(mp[i], res(i), *m_p_div, *m_p_mont, m_hp);
+    lfunMul(mq, res(k + i), *m_q_div, *m_q_mont, m_hq);
+
+    sub_into(t, *m_q, mp[i]);
+    addmod_into(r, mq, t, *m_q_mont);
+    mulmod_into(u[i], r, m_pinverse, *m_q_mont);
+  }
+}
+
+void PrivateKey::obfuscatorCRTChunk(BigNumber* obf, const BigNumber* r,
+                                    int k, const BigNumber* hs) const {
+  const MontContext& psq = *m_psq_mont;
+  const MontContext& qsq = *m_qsq_mont;
+  const int w = std::max(psq.getLimbs(), qsq.getLimbs());
+  const int mod_bits = std::max(m_psquare.BitSize(), m_qsquare.BitSize());
+
+  // Lanes of w limbs as in decryptCRTChunk, p halves in lanes [0, k) and
+  // q halves in [k, 2k), followed by the exponents and moduli
+  std::vector<Ipp64u> buff((3 * IPCL_CRYPTO_MB_SIZE + 2) * w, 0);
+  auto base = [&](int i) { return buff.data() + i * w; };
+  auto res = [&](int i) {
+    return buff.data() + (IPCL_CRYPTO_MB_SIZE + i) * w;
+  };
+  auto rexp = [&](int i) {
+    return buff.data() + (2 * IPCL_CRYPTO_MB_SIZE + i) * w;
+  };
+  Ipp64u* psq_l = rexp(IPCL_CRYPTO_MB_SIZE);
+  Ipp64u* qsq_l = psq_l + w;
+  toLimbs(psq_l, w, m_psquare);
+  toLimbs(qsq_l, w, m_qsquare);
+
+  // Normal: r^(n mod phi(p^2)) mod p^2, DJN: (hs mod p^2)^r mod p^2 with
+  // r of randbits bits, below phi(p^2) unless given by setRandom
+  const BigNumber phi[2] = {m_psquare - *m_p, m_qsquare - *m_q};
+  int exp_bits = 0;
+  Ipp64u* out[IPCL_CRYPTO_MB_SIZE];
+  const Ipp64u* in[IPCL_CRYPTO_MB_SIZE];
+  const Ipp64u* exp[IPCL_CRYPTO_MB_SIZE];
+  const Ipp64u* mod[IPCL_CRYPTO_MB_SIZE];
+  for (int i = 0; i < 2 * k; i++) {
+    bool q_half = i >= k;
+    const BigNumber& ri = r[q_half ? i - k : i];
+    const BigNumber& phi_exp = q_half ? m_n_phiq : m_n_phip;
+    if (hs) {
+      toLimbs(base(i), w, hs[q_half ? 1 : 0]);
+      const BigNumber& phi_i = phi[q_half ? 1 : 0];
+      BigNumber e = ri.BitSize() < phi_i.BitSize() ? ri : ri % phi_i;
+      toLimbs(rexp(i), w, e);
+      exp_bits = std::max(exp_bits, e.BitSize());
+    } else {
+      reduceInto(base(i), ri, q_half ? qsq : psq);
+      toLimbs(rexp(i), w, phi_exp);
+      exp_bits = std::max(exp_bits, phi_exp.BitSize());
+    }
+    out[i] = res(i);
+    in[i] = base(i);
+    exp[i] = rexp(i);
+    mod[i] = q_half ? qsq_l : psq_l;
+  }
+  modExpLanes(out, in, exp, std::max(exp_bits, 1), mod, mod_bits, 2 * k);
+
+  // obf = xp + p^2 * ((xq - xp) * (p^2)^(-1) mod q^2), with xp < p^2 < q^2
+  const int words = m_nsquare->DwordSize();
+  BigNumber xp(0, words), xq(0, words), t(0, words), u(0, words);
+  for (int i = 0; i < k; i++) {
+    psq.store(xp, res(i));
+    qsq.store(xq, res(k + i));
+    sub_into(t, m_qsquare, xp);
+    addmod_into(t, xq, t, qsq);
+    mulmod_into(t, t, m_psqinverse, qsq);
+    mul_into(u, t, m_psquare);
+    add_into(obf[i], xp, u);
+  }
 }
 
 BigNumber PrivateKey::computeLfun(const BigNumber& a,
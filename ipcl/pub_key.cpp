@@ -28,6 +28,13 @@ PublicKey::PublicKey(const BigNumber& n, int bits, bool enableDJN_)
       m_testv(false),
       m_hs(0),
       m_randbits(0) {
+  m_n_mont = std::make_shared<MontContext>(*m_n);
+  m_nsq_mont = std::make_shared<MontContext>(*m_nsquare);
+  m_nsq_engine = std::make_shared<ModMulEngine>(m_nsq_mont);
+  m_n_reducer =
+      std::make_shared<ModReducer>(*m_n, ModReducer::Method::Barrett);
+  m_nm1_reducer =
+      std::make_shared<ModReducer>(*m_n - 1, ModReducer::Method::Barrett);
   if (enableDJN_) this->enableDJN();  // sets m_enable_DJN
   m_isInitialized = true;
 }
@@ -38,47 +45,43 @@ void PublicKey::enableDJN() {
   do {
     int rand_bit = (*m_n).BitSize();
     BigNumber rand = getRandomBN(rand_bit + 128);
-    rmod = rand % (*m_n);
+    rmod = m_n_reducer->reduce(rand);
     gcd = rand.gcd(*m_n);
   } while (gcd.compare(1));
 
-  BigNumber rmod_sq = rmod * rmod;
-  BigNumber rmod_neg = rmod_sq * -1;
-  BigNumber h = rmod_neg % (*m_n);
+  // h = -rmod^2 mod n
+  BigNumber h = (*m_n).InverseAdd(m_n_reducer->mulmod(rmod, rmod));
   m_hs = modExp(h, *m_n, *m_nsquare);
   m_randbits = m_bits >> 1;  // bits/2
 
   m_enable_DJN = true;
 }
 
-std::vector<BigNumber> PublicKey::getDJNObfuscator(std::size_t sz) const {
-  std::vector<BigNumber> r(sz);
-  std::vector<BigNumber> base(sz, m_hs);
-  std::vector<BigNumber> sq(sz, *m_nsquare);
+std::vector<BigNumber> PublicKey::getObfuscatorRandom(std::size_t sz) const {
+  if (m_testv) return m_r;
 
-  if (m_testv) {
-    r = m_r;
+  std::vector<BigNumber> r(sz);
+  if (m_enable_DJN) {
+    for (auto& r_ : r) r_ = getRandomBN(m_randbits);
   } else {
-    for (auto& r_ : r) {
-      r_ = getRandomBN(m_randbits);
-    }
+    for (auto& r_ : r) r_ = getRandomBN(m_bits);
+    m_nm1_reducer->reduce(r, r);
+    for (auto& r_ : r) r_ += BigNumber::One();
   }
+  return r;
+}
+
+std::vector<BigNumber> PublicKey::getDJNObfuscator(std::size_t sz) const {
+  std::vector<BigNumber> r = getObfuscatorRandom(sz);
+  std::vector<BigNumber> base(sz, m_hs);
+  std::vector<BigNumber> sq(sz, *m_nsquare);
   return modExp(base, r, sq);
 }
 
 std::vector<BigNumber> PublicKey::getNormalObfuscator(std::size_t sz) const {
-  std::vector<BigNumber> r(sz);
+  std::vector<BigNumber> r = getObfuscatorRandom(sz);
   std::vector<BigNumber> sq(sz, *m_nsquare);
   std::vector<BigNumber> pown(sz, *m_n);
-
-  if (m_testv) {
-    r = m_r;
-  } else {
-    for (int i = 0; i < sz; i++) {
-      r[i] = getRandomBN(m_bits);
-      r[i] = r[i] % (*m_n - 1) + 1;
-    }
-  }
   return modExp(r, pown, sq);
 }
 
@@ -86,10 +89,8 @@ void PublicKey::applyObfuscator(std::vector<BigNumber>& ciphertext) const {
   std::size_t sz = ciphertext.size();
   std::vector<BigNumber> obfuscator =
       m_enable_DJN ? getDJNObfuscator(sz) : getNormalObfuscator(sz);
-  BigNumber sq = *m_nsquare;
 
-  for (std::size_t i = 0; i < sz; ++i)
-    ciphertext[i] = sq.ModMul(ciphertext[i], obfuscator[i]);
+  m_nsq_engine->modMul(ciphertext, ciphertext, obfuscator);
 }
 
 void PublicKey::setRandom(const std::vector<BigNumber>& r) {
@@ -99,14 +100,37 @@ void PublicKey::setRandom(const std::vector<BigNumber>& r) {
 
 void PublicKey::setHS(const BigNumber& hs) { m_hs = hs; }
 
+void PublicKey::powG(std::vector<BigNumber>& r,
+                     const std::vector<BigNumber>& pt) const {
+  const std::size_t pt_size = pt.size();
+  const MontContext& n_ctx = *m_n_mont;
+  const int l = n_ctx.getLimbs();
+  r.resize(pt_size);
+
+#ifdef IPCL_USE_OMP
+  int omp_remaining_threads = OMPUtilities::MaxThreads;
+#pragma omp parallel for num_threads( \
+    OMPUtilities::assignOMPThreads(omp_remaining_threads, pt_size))
+#endif  // IPCL_USE_OMP
+  for (std::size_t i = 0; i < pt_size; i++) {
+    dispatchLimbs(l, [&](auto L) {
+      constexpr int N = decltype(L)::value;
+      Ipp64u u[2 * limb::len<N>(IPCL_MAX_LIMBS)];
+      LimbArray<N> t;
+
+      m_n_reducer->load(t.data(), pt[i]);
+      limb::mul<N>(u, t.data(), n_ctx.mod(), l);
+      for (int j = 0; j < 2 * l; j++)
+        if (++u[j] != 0) break;
+      m_nsq_mont->store(r[i], u);
+    });
+  }
+}
+
 std::vector<BigNumber> PublicKey::raw_encrypt(const std::vector<BigNumber>& pt,
                                               bool make_secure) const {
-  std::size_t pt_size = pt.size();
-
-  std::vector<BigNumber> ct(pt_size);
-
-  for (std::size_t i = 0; i < pt_size; i++)
-    ct[i] = (*m_n * pt[i] + 1) % (*m_nsquare);
+  std::vector<BigNumber> ct;
+  powG(ct, pt);
 
   if (make_secure) applyObfuscator(ct);
 
@@ -132,6 +156,29 @@ CipherText PublicKey::encrypt(const PlainText& pt, bool make_secure) const {
   return CipherText(*this, ct_bn_v);
 }
 
+void PublicKey::encryptStream(const BigNumberSource& source,
+                              const BigNumberSink& sink, bool make_secure,
+                              std::size_t chunk_size) const {
+  ERROR_CHECK(m_isInitialized,
+              "encryptStream: Public key is NOT initialized.");
+  ERROR_CHECK(!(make_secure && m_testv),
+              "encryptStream: setRandom values cover one encrypt call only");
+
+  // If hybrid OPTIMAL mode is used, use a special ratio
+  if (isHybridOptimal()) {
+    float qat_ratio = (chunk_size <= IPCL_WORKLOAD_SIZE_THRESHOLD)
+                          ? IPCL_HYBRID_MODEXP_RATIO_FULL
+                          : IPCL_HYBRID_MODEXP_RATIO_ENCRYPT;
+    setHybridRatio(qat_ratio, false);
+  }
+
+  auto stage = [this, make_secure](std::vector<BigNumber>& ct,
+                                   const std::vector<BigNumber>& pt) {
+    ct = raw_encrypt(pt, make_secure);
+  };
+  runPipeline(source, stage, sink, chunk_size);
+}
+
 void PublicKey::encrypt2(const PlainText& pt, void** destination, bool make_secure) const {
   ERROR_CHECK(m_isInitialized, "encrypt: Public key is NOT initialized.");
 
@@ -176,6 +223,13 @@ void PublicKey::create(const BigNumber& n, int bits, bool enableDJN_) {
   // m_n = std::make_shared<BigNumber>(n);  // We've already altered m_n.
   m_g = std::make_shared<BigNumber>(*m_n + 1);
   m_nsquare = std::make_shared<BigNumber>((*m_n) * (*m_n));
+  m_n_mont = std::make_shared<MontContext>(*m_n);
+  m_nsq_mont = std::make_shared<MontContext>(*m_nsquare);
+  m_nsq_engine = std::make_shared<ModMulEngine>(m_nsq_mont);
+  m_n_reducer =
+      std::make_shared<ModReducer>(*m_n, ModReducer::Method::Barrett);
+  m_nm1_reducer =
+      std::make_shared<ModReducer>(*m_n - 1, ModReducer::Method::Barrett);
   m_bits = bits;
   m_dwords = BITSIZE_DWORD(m_bits * 2);
   m_enable_DJN = enableDJN_;
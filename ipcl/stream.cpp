@@ -0,0 +1,144 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ipcl/stream.hpp"
+
+#include <condition_variable>  // NOLINT
+#include <exception>
+#include <mutex>  // NOLINT
+#include <string>
+
+#include "ipcl/utils/util.hpp"
+
+namespace ipcl {
+
+namespace {
+
+// Bookkeeping shared by the workers of one pipeline
+struct PipelineState {
+  std::mutex read_mutex;   ///< Serializes the source
+  std::mutex write_mutex;  ///< Serializes the sink and guards the fields below
+  std::condition_variable written;
+  std::size_t next_seq = 0;     ///< Sequence number of the next chunk read
+  std::size_t next_offset = 0;  ///< Stream index of the next chunk read
+  std::size_t next_write = 0;   ///< Sequence number of the next chunk written
+  bool exhausted = false;
+  bool failed = false;
+  std::exception_ptr error;
+
+  void fail(std::exception_ptr e) {
+    {
+      std::lock_guard<std::mutex> lock(write_mutex);
+      if (!failed) error = e;
+      failed = true;
+    }
+    written.notify_all();
+  }
+
+  bool stopped() {
+    std::lock_guard<std::mutex> lock(write_mutex);
+    return failed;
+  }
+};
+
+// One worker, read, transform and write chunks until the source is
+// exhausted or a stage fails. Exceptions never leave the worker.
+void pipelineWorker(PipelineState& st, const BigNumberSource& source,
+                    const BigNumberStage& stage, const BigNumberSink& sink,
+                    std::size_t chunk_size) {
+  std::vector<BigNumber> in, out;
+  in.reserve(chunk_size);
+
+  for (;;) {
+    std::size_t seq, offset;
+    try {
+      std::lock_guard<std::mutex> lock(st.read_mutex);
+      if (st.exhausted || st.stopped()) return;
+      in.clear();
+      if (!source(in, chunk_size)) {
+        st.exhausted = true;
+        return;
+      }
+      ERROR_CHECK(!in.empty() && in.size() <= chunk_size,
+                  "runPipeline: source returned an invalid chunk");
+      seq = st.next_seq++;
+      offset = st.next_offset;
+      st.next_offset += in.size();
+    } catch (...) {
+      st.fail(std::current_exception());
+      return;
+    }
+
+    try {
+      out.clear();
+      stage(out, in);
+      ERROR_CHECK(out.size() == in.size(),
+                  "runPipeline: stage changed the chunk size");
+    } catch (...) {
+      st.fail(std::current_exception());
+      return;
+    }
+
+    // Chunks leave in stream order
+    std::unique_lock<std::mutex> lock(st.write_mutex);
+    st.written.wait(lock, [&] { return st.failed || st.next_write == seq; });
+    if (st.failed) return;
+    try {
+      sink(offset, out);
+    } catch (...) {
+      st.failed = true;
+      st.error = std::current_exception();
+    }
+    st.next_write++;
+    lock.unlock();
+    st.written.notify_all();
+  }
+}
+
+}  // namespace
+
+void runPipeline(const BigNumberSource& source, const BigNumberStage& stage,
+                 const BigNumberSink& sink, std::size_t chunk_size,
+                 int workers) {
+  ERROR_CHECK(chunk_size > 0, "runPipeline: chunk size must be positive");
+
+  PipelineState st;
+#ifdef IPCL_USE_OMP
+  if (workers <= 0) workers = OMPUtilities::MaxThreads;
+  // Stages run their own OpenMP loops, which stay on the worker thread
+  // inside this region unless nested parallelism is enabled
+#pragma omp parallel num_threads(workers)
+  pipelineWorker(st, source, stage, sink, chunk_size);
+#else
+  pipelineWorker(st, source, stage, sink, chunk_size);
+#endif  // IPCL_USE_OMP
+
+  if (st.error) std::rethrow_exception(st.error);
+}
+
+BigNumberSource istreamSource(std::istream& is) {
+  return [&is](std::vector<BigNumber>& chunk, std::size_t max) {
+    std::string s;
+    while (chunk.size() < max && is >> s) chunk.emplace_back(s.c_str());
+    ERROR_CHECK(!is.bad(), "istreamSource: read error");
+    return !chunk.empty();
+  };
+}
+
+BigNumberSink ostreamSink(std::ostream& os) {
+  return [&os](std::size_t, std::vector<BigNumber>& chunk) {
+    std::string s;
+    for (const BigNumber& x : chunk) {
+      s.clear();
+      x.num2hex(s);
+      // num2hex leaves the sign position blank for non-negative values and
+      // writes no digit for zero
+      if (s.front() == ' ') s.erase(0, 1);
+      if (s.back() == 'x') s.push_back('0');
+      os << s << '\n';
+    }
+    ERROR_CHECK(os.good(), "ostreamSink: write error");
+  };
+}
+
+}  // namespace ipcl
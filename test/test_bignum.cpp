@@ -0,0 +1,249 @@
+// Copyright (C) 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ipcl/fixed_bignum.hpp"
+#include "ipcl/mod_exp.hpp"
+#include "ipcl/mod_inv.hpp"
+#include "ipcl/mod_mul.hpp"
+#include "ipcl/mod_reduce.hpp"
+#include "ipcl/multi_exp.hpp"
+
+namespace {
+
+BigNumber randomBN(std::mt19937& rng, int limbs, bool odd = false) {
+  std::vector<Ipp32u> words(limbs * 2);
+  for (auto& w : words) w = rng();
+  words.back() |= 0x80000000;
+  if (odd) words[0] |= 1;
+  return BigNumber(words.data(), words.size());
+}
+
+void checkMontContext(int limbs) {
+  std::mt19937 rng(limbs);
+  BigNumber m = randomBN(rng, limbs, true);
+  ipcl::MontContext ctx(m);
+  ASSERT_EQ(ctx.getLimbs(), limbs);
+
+  for (int i = 0; i < 8; i++) {
+    BigNumber a = randomBN(rng, limbs) % m;
+    BigNumber b = randomBN(rng, limbs) % m;
+    BigNumber x = randomBN(rng, limbs * 2);
+
+    EXPECT_EQ(ctx.modMul(a, b), a * b % m);
+    EXPECT_EQ(ctx.modAdd(a, b), (a + b) % m);
+
+    ipcl::dispatchLimbs(limbs, [&](auto L) {
+      constexpr int N = decltype(L)::value;
+      std::vector<Ipp64u> wide(limbs * 2);
+      ipcl::LimbArray<N> r, y;
+
+      Ipp32u* data;
+      int bits;
+      ippsRef_BN(nullptr, &bits, &data, BN(x));
+      std::memcpy(wide.data(), data, BITSIZE_WORD(bits) * sizeof(Ipp32u));
+      ctx.reduce<N>(r.data(), wide.data());
+      EXPECT_EQ(ctx.store(r.data()), x % m);
+
+      ctx.load(y.data(), a);
+      ctx.toMont<N>(r.data(), y.data());
+      ctx.fromMont<N>(r.data(), r.data());
+      EXPECT_EQ(ctx.store(r.data()), a);
+    });
+  }
+}
+
+}  // namespace
+
+TEST(BigNumberTest, MontContextStandardLimbsTest) {
+  for (int limbs : {16, 32, 64}) checkMontContext(limbs);
+}
+
+TEST(BigNumberTest, MontContextDynamicLimbsTest) {
+  // 20 limbs is not a standard key size and runs the runtime-sized kernels
+  checkMontContext(20);
+}
+
+TEST(BigNumberTest, MontContextReduceInputTest) {
+  std::mt19937 rng(1);
+  BigNumber m = randomBN(rng, 16, true);
+  ipcl::MontContext ctx(m);
+
+  BigNumber big = randomBN(rng, 40);
+  BigNumber neg = BigNumber::Zero() - randomBN(rng, 8);
+  EXPECT_EQ(ctx.modMul(big, BigNumber::One()), big % m);
+  EXPECT_EQ(ctx.modMul(neg, BigNumber::One()), neg % m);
+  EXPECT_EQ(ctx.modAdd(m, m), BigNumber::Zero());
+}
+
+TEST(BigNumberTest, OutputParameterArithmeticTest) {
+  std::mt19937 rng(2);
+  BigNumber m = randomBN(rng, 32, true);
+  ipcl::MontContext ctx(m);
+  BigNumber out, q, r, scratch;
+
+  for (int i = 0; i < 4; i++) {
+    BigNumber a = randomBN(rng, 32) % m;
+    BigNumber b = randomBN(rng, 16);
+
+    add_into(out, a, b);
+    EXPECT_EQ(out, a + b);
+    sub_into(out, b, a);
+    EXPECT_EQ(out, b - a);
+    mul_into(out, a, b);
+    EXPECT_EQ(out, a * b);
+    mod_into(out, a * b, m);
+    EXPECT_EQ(out, a * b % m);
+    div_into(q, r, a, b);
+    EXPECT_EQ(q, a / b);
+    EXPECT_EQ(r, a % b);
+    mulmod_into(out, a, b, m, scratch);
+    EXPECT_EQ(out, a * b % m);
+
+    int capacity = out.Capacity();
+    ipcl::mulmod_into(out, a, b, ctx);
+    EXPECT_EQ(out, a * b % m);
+    ipcl::addmod_into(out, out, a, ctx);
+    EXPECT_EQ(out, (a * b + a) % m);
+    EXPECT_EQ(out.Capacity(), capacity);
+  }
+}
+
+TEST(BigNumberTest, ModMulEngineTest) {
+  std::mt19937 rng(3);
+  for (int limbs : {20, 32, 64}) {
+    BigNumber m = randomBN(rng, limbs, true);
+    ipcl::ModMulEngine engine(std::make_shared<ipcl::MontContext>(m));
+
+    // 19 elements leave a partially filled chunk of 8 lanes
+    std::vector<BigNumber> a(19), b(19);
+    for (int i = 0; i < 19; i++) {
+      a[i] = randomBN(rng, limbs) % m;
+      b[i] = randomBN(rng, limbs * 2);
+    }
+    b[0] = m - 1;
+    a[1] = m - 1;
+    b[1] = m - 1;
+
+    std::vector<BigNumber> r = engine.modMul(a, b);
+    for (int i = 0; i < 19; i++) EXPECT_EQ(r[i], a[i] * b[i] % m);
+
+    std::vector<BigNumber> b0(1, b[2]);
+    std::vector<BigNumber> c = a;
+    engine.modMul(c, c, b0);
+    for (int i = 0; i < 19; i++) EXPECT_EQ(c[i], a[i] * b[2] % m);
+  }
+}
+
+TEST(BigNumberTest, ModMulEngineProductTest) {
+  std::mt19937 rng(4);
+  BigNumber m = randomBN(rng, 32, true);
+  ipcl::ModMulEngine engine(std::make_shared<ipcl::MontContext>(m));
+
+  for (int size : {1, 5, 17, 100}) {
+    std::vector<BigNumber> a(size);
+    BigNumber expected = BigNumber::One();
+    for (int i = 0; i < size; i++) {
+      a[i] = randomBN(rng, 32) % m;
+      expected = expected * a[i] % m;
+    }
+    EXPECT_EQ(engine.product(a), expected);
+  }
+}
+
+TEST(BigNumberTest, MultiExpTest) {
+  std::mt19937 rng(5);
+  BigNumber m = randomBN(rng, 16, true);
+  ipcl::MontContext ctx(m);
+
+  // Straus for the short input, Pippenger for the long one
+  for (int size : {1, 7, 80}) {
+    std::vector<BigNumber> base(size), exp(size);
+    BigNumber expected = BigNumber::One();
+    for (int i = 0; i < size; i++) {
+      base[i] = randomBN(rng, 16) % m;
+      exp[i] = randomBN(rng, 1 + i % 4);
+      if (i % 5 == 0) exp[i] = BigNumber::Zero();
+      expected = expected * ipcl::modExp(base[i], exp[i], m) % m;
+    }
+    EXPECT_EQ(ipcl::multiExp(base, exp, ctx), expected);
+  }
+}
+
+TEST(BigNumberTest, BatchInverseTest) {
+  std::mt19937 rng(6);
+  // Mersenne prime 2^127 - 1, every non-zero element is invertible
+  std::vector<Ipp32u> words = {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x7FFFFFFF};
+  BigNumber m(words.data(), words.size());
+
+  for (int size : {1, 5, 300}) {
+    std::vector<BigNumber> a(size);
+    for (int i = 0; i < size; i++) {
+      a[i] = randomBN(rng, 2) % m;
+      if (a[i] == BigNumber::Zero()) a[i] = BigNumber::One();
+    }
+    std::vector<BigNumber> inv = ipcl::batchInverse(a, m);
+    ASSERT_EQ(inv.size(), size);
+    for (int i = 0; i < size; i++) EXPECT_EQ(inv[i], m.InverseMul(a[i]));
+  }
+
+  std::vector<BigNumber> zero = {BigNumber::One(), BigNumber::Zero()};
+  EXPECT_THROW(ipcl::batchInverse(zero, m), std::runtime_error);
+}
+
+TEST(BigNumberTest, ExactDivisorTest) {
+  std::mt19937 rng(7);
+  // Standard and dynamic limb counts
+  for (int limbs : {1, 16, 20}) {
+    BigNumber d = randomBN(rng, limbs, true);
+    ipcl::ExactDivisor div(d);
+    ASSERT_EQ(div.getLimbs(), limbs);
+    for (int i = 0; i < 4; i++) {
+      BigNumber q = randomBN(rng, limbs) % d;
+      EXPECT_EQ(div.divide(q * d), q);
+    }
+    EXPECT_EQ(div.divide(BigNumber::Zero()), BigNumber::Zero());
+  }
+}
+
+TEST(BigNumberTest, ModReducerTest) {
+  std::mt19937 rng(8);
+  using Method = ipcl::ModReducer::Method;
+
+  // Standard and dynamic limb counts, Barrett also with an even modulus
+  for (int limbs : {16, 20}) {
+    for (bool odd : {true, false}) {
+      BigNumber m = randomBN(rng, limbs, odd);
+      std::vector<ipcl::ModReducer> reducers = {
+          ipcl::ModReducer(m, Method::Barrett)};
+      if (odd) reducers.emplace_back(m, Method::Montgomery);
+
+      // Short, double width, negative and too wide inputs
+      std::vector<BigNumber> a = {randomBN(rng, limbs / 2),
+                                  randomBN(rng, 2 * limbs),
+                                  BigNumber::Zero() - randomBN(rng, limbs),
+                                  randomBN(rng, 2 * limbs + 3),
+                                  randomBN(rng, 5 * limbs + 1),
+                                  BigNumber::Zero() - randomBN(rng, 3 * limbs),
+                                  BigNumber::Zero() - m, m};
+      std::vector<BigNumber> b = {randomBN(rng, limbs)};
+
+      for (const auto& red : reducers) {
+        std::vector<BigNumber> r, prod, sum;
+        red.reduce(r, a);
+        red.mulmod(prod, a, b);
+        red.addmod(sum, a, b);
+        ASSERT_EQ(r.size(), a.size());
+        for (std::size_t i = 0; i < a.size(); i++) {
+          EXPECT_EQ(r[i], a[i] % m);
+          EXPECT_EQ(prod[i], a[i] * b[0] % m);
+          EXPECT_EQ(sum[i], (a[i] + b[0]) % m);
+        }
+      }
+    }
+  }
+}
@@ -3,6 +3,7 @@
 
 #include <climits>
 #include <random>
+#include <sstream>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -186,3 +187,274 @@ TEST(CryptoTest, ISO_IEC_18033_6_ComplianceTest) {
   m1m2.num2hex(str4);
   EXPECT_EQ(str4, dt_sum.getElementHex(0));
 }
+
+TEST(CryptoTest, RawEncryptTest) {
+  const uint32_t num_values = SELF_DEF_NUM_VALUES;
+
+  ipcl::KeyPair key = ipcl::generateKeypair(2048);
+  const BigNumber& n = *(key.pub_key.getN());
+  const BigNumber& nsq = *(key.pub_key.getNSQ());
+
+  std::random_device dev;
+  std::mt19937 rng(dev());
+  std::uniform_int_distribution<std::mt19937::result_type> dist(0, UINT_MAX);
+
+  std::vector<BigNumber> exp_value(num_values);
+  for (int i = 0; i < num_values; i++)
+    exp_value[i] = BigNumber(static_cast<uint32_t>(dist(rng)));
+  exp_value[0] = BigNumber::Zero();
+  exp_value[1] = n - 1;
+  exp_value[2] = n;
+  exp_value[3] = nsq + 7;
+
+  ipcl::CipherText ct = key.pub_key.encrypt(ipcl::PlainText(exp_value), false);
+  ipcl::PlainText dt = key.priv_key.decrypt(ct);
+  for (int i = 0; i < num_values; i++) {
+    EXPECT_EQ(ct.getElement(i), (n * exp_value[i] + 1) % nsq);
+    EXPECT_EQ(dt.getElement(i), exp_value[i] % n);
+  }
+}
+
+TEST(CryptoTest, DecryptCRTChunkTest) {
+  ipcl::KeyPair key = ipcl::generateKeypair(2048, true);
+  ipcl::PrivateKey raw_key = key.priv_key;
+  raw_key.enableCRT(false);
+
+  std::random_device dev;
+  std::mt19937 rng(dev());
+  std::uniform_int_distribution<std::mt19937::result_type> dist(0, UINT_MAX);
+
+  // Partial, full and mixed chunks of IPCL_CRT_CHUNK_SIZE
+  for (int num_values : {1, 4, 5, 8, 21}) {
+    std::vector<uint32_t> exp_value(num_values);
+    for (int i = 0; i < num_values; i++) exp_value[i] = dist(rng);
+
+    ipcl::CipherText ct = key.pub_key.encrypt(ipcl::PlainText(exp_value));
+    ipcl::PlainText dt = key.priv_key.decrypt(ct);
+    ipcl::PlainText dt_raw = raw_key.decrypt(ct);
+    for (int i = 0; i < num_values; i++) {
+      EXPECT_EQ(dt.getElement(i), BigNumber(exp_value[i]));
+      EXPECT_EQ(dt_raw.getElement(i), BigNumber(exp_value[i]));
+    }
+  }
+}
+
+TEST(CryptoTest, DecryptToTest) {
+  ipcl::KeyPair key = ipcl::generateKeypair(1024, true);
+  ipcl::PrivateKey raw_key = key.priv_key;
+  raw_key.enableCRT(false);
+  const BigNumber& n = *(key.pub_key.getN());
+
+  auto toBN = [](uint64_t v) {
+    Ipp32u words[2] = {static_cast<Ipp32u>(v), static_cast<Ipp32u>(v >> 32)};
+    return BigNumber(words, 2);
+  };
+  // Signed values are encrypted as n - |m|
+  auto encode = [&](int64_t v) {
+    return v >= 0 ? toBN(v) : n - toBN(~static_cast<uint64_t>(v) + 1);
+  };
+
+  std::vector<uint64_t> u_value = {0, 1, 12345, UINT64_MAX, 1ull << 63};
+  std::vector<int64_t> s_value = {0, -1, INT64_MAX, INT64_MIN, -987654321};
+  std::vector<BigNumber> u_bn, s_bn;
+  for (uint64_t v : u_value) u_bn.push_back(toBN(v));
+  for (int64_t v : s_value) s_bn.push_back(encode(v));
+
+  ipcl::CipherText u_ct = key.pub_key.encrypt(ipcl::PlainText(u_bn));
+  ipcl::CipherText s_ct = key.pub_key.encrypt(ipcl::PlainText(s_bn));
+
+  for (const ipcl::PrivateKey* sk : {&key.priv_key, &raw_key}) {
+    std::vector<uint64_t> u_out(u_value.size());
+    std::vector<int64_t> s_out(s_value.size());
+    sk->decrypt_to(u_ct, u_out.data(), u_out.size());
+    sk->decrypt_to(s_ct, s_out.data(), s_out.size());
+    EXPECT_EQ(u_out, u_value);
+    EXPECT_EQ(s_out, s_value);
+
+    // 2^64 and 2^63 do not fit, negative values are not unsigned
+    std::vector<uint64_t> u_bad(1);
+    std::vector<int64_t> s_bad(1);
+    ipcl::CipherText big =
+        key.pub_key.encrypt(ipcl::PlainText(toBN(UINT64_MAX) + 1));
+    EXPECT_THROW(sk->decrypt_to(big, u_bad.data(), 1), std::runtime_error);
+    EXPECT_THROW(sk->decrypt_to(u_ct.getCipherText(4), s_bad.data(), 1),
+                 std::runtime_error);
+    EXPECT_THROW(sk->decrypt_to(s_ct.getCipherText(1), u_bad.data(), 1),
+                 std::runtime_error);
+    EXPECT_THROW(sk->decrypt_to(u_ct, u_bad.data(), 1), std::runtime_error);
+  }
+}
+
+TEST(CryptoTest, DecryptStreamTest) {
+  ipcl::KeyPair key = ipcl::generateKeypair(1024, true);
+  ipcl::PrivateKey raw_key = key.priv_key;
+  raw_key.enableCRT(false);
+
+  const int num_values = 37;
+  std::vector<uint32_t> exp_value(num_values);
+  for (int i = 0; i < num_values; i++) exp_value[i] = i * 7919;
+  ipcl::CipherText ct = key.pub_key.encrypt(ipcl::PlainText(exp_value));
+  std::vector<BigNumber> ct_bn = ct.getTexts();
+
+  for (const ipcl::PrivateKey* sk : {&key.priv_key, &raw_key}) {
+    // Whole CipherText, and an iterator range with a sink checking the order
+    std::vector<BigNumber> pt;
+    sk->decryptStream(ipcl::textSource(ct), ipcl::vectorSink(pt), 8);
+    ASSERT_EQ(pt.size(), num_values);
+    for (int i = 0; i < num_values; i++)
+      EXPECT_EQ(pt[i], BigNumber(exp_value[i]));
+
+    std::size_t next = 0;
+    sk->decryptStream(
+        ipcl::rangeSource(ct_bn.begin(), ct_bn.end()),
+        [&](std::size_t offset, std::vector<BigNumber>& chunk) {
+          EXPECT_EQ(offset, next);
+          EXPECT_LE(chunk.size(), 5);
+          for (std::size_t j = 0; j < chunk.size(); j++)
+            EXPECT_EQ(chunk[j], BigNumber(exp_value[offset + j]));
+          next += chunk.size();
+        },
+        5);
+    EXPECT_EQ(next, num_values);
+  }
+
+  // Concurrent workers still deliver in stream order
+  std::vector<BigNumber> out;
+  ipcl::runPipeline(
+      ipcl::rangeSource(ct_bn.begin(), ct_bn.end()),
+      [&](std::vector<BigNumber>& chunk_pt,
+          const std::vector<BigNumber>& chunk_ct) {
+        chunk_pt =
+            key.priv_key.decrypt(ipcl::CipherText(key.pub_key, chunk_ct))
+                .getTexts();
+      },
+      ipcl::vectorSink(out), 3, 4);
+  ASSERT_EQ(out.size(), num_values);
+  for (int i = 0; i < num_values; i++)
+    EXPECT_EQ(out[i], BigNumber(exp_value[i]));
+
+  // Errors of the source reach the caller
+  auto failing = [](std::vector<BigNumber>&, std::size_t) -> bool {
+    throw std::runtime_error("source failure");
+  };
+  std::vector<BigNumber> pt;
+  EXPECT_THROW(key.priv_key.decryptStream(failing, ipcl::vectorSink(pt)),
+               std::runtime_error);
+}
+
+TEST(CryptoTest, EncryptStreamTest) {
+  ipcl::KeyPair key = ipcl::generateKeypair(1024, true);
+
+  const int num_values = 29;
+  std::vector<uint32_t> exp_value(num_values);
+  for (int i = 0; i < num_values; i++) exp_value[i] = i * 104729;
+  exp_value[3] = 0;
+  ipcl::PlainText pt(exp_value);
+
+  // Plaintext to a file-like stream of ciphertexts and back
+  std::stringstream file;
+  key.pub_key.encryptStream(ipcl::textSource(pt), ipcl::ostreamSink(file),
+                            true, 8);
+  std::vector<BigNumber> dt;
+  key.priv_key.decryptStream(ipcl::istreamSource(file), ipcl::vectorSink(dt),
+                             8);
+  ASSERT_EQ(dt.size(), num_values);
+  for (int i = 0; i < num_values; i++)
+    EXPECT_EQ(dt[i], BigNumber(exp_value[i]));
+
+  // Without obfuscation the chunks match a whole encryption
+  std::vector<BigNumber> ct;
+  key.pub_key.encryptStream(ipcl::textSource(pt), ipcl::vectorSink(ct), false,
+                            5);
+  EXPECT_EQ(ct, key.pub_key.encrypt(pt, false).getTexts());
+}
+
+TEST(CryptoTest, KeyOwnerEncryptTest) {
+  const int num_values = 11;
+  std::vector<uint32_t> exp_value(num_values);
+  for (int i = 0; i < num_values; i++) exp_value[i] = i * 65537 + 3;
+  ipcl::PlainText pt(exp_value);
+
+  for (bool djn : {false, true}) {
+    ipcl::KeyPair key = ipcl::generateKeypair(1024, djn);
+
+    // Fresh randomness decrypts to the plaintext
+    ipcl::CipherText ct = key.priv_key.encrypt(key.pub_key, pt);
+    ipcl::PlainText dt = key.priv_key.decrypt(ct);
+    for (int i = 0; i < num_values; i++)
+      EXPECT_EQ(dt.getElement(i), BigNumber(exp_value[i]));
+
+    // The same random values give the public-key ciphertexts
+    key.pub_key.setRandom(key.pub_key.getObfuscatorRandom(num_values));
+    EXPECT_EQ(key.priv_key.encrypt(key.pub_key, pt).getTexts(),
+              key.pub_key.encrypt(pt).getTexts());
+  }
+}
+
+TEST(CryptoTest, SlotPackingTest) {
+  const uint32_t num_values = 60;
+  ipcl::KeyPair key = ipcl::generateKeypair(1024, true);
+  ipcl::SlotPacker packer(key.pub_key, 32, 8);
+  EXPECT_EQ(packer.getSlotCount(), 1023 / 40);
+
+  std::vector<uint32_t> exp_value1(num_values), exp_value2(num_values);
+  std::random_device dev;
+  std::mt19937 rng(dev());
+  std::uniform_int_distribution<std::mt19937::result_type> dist(0, UINT_MAX);
+  for (uint32_t i = 0; i < num_values; i++) {
+    exp_value1[i] = dist(rng);
+    exp_value2[i] = dist(rng);
+  }
+
+  // Plain PublicKey::encrypt and PrivateKey::decrypt of packed elements
+  ipcl::PlainText pt = packer.pack(exp_value1);
+  EXPECT_EQ(pt.getSize(), packer.getPackedSize(num_values));
+  std::vector<BigNumber> dt =
+      packer.unpack(key.priv_key.decrypt(key.pub_key.encrypt(pt)), num_values);
+  for (uint32_t i = 0; i < num_values; i++)
+    EXPECT_EQ(dt[i], BigNumber(exp_value1[i]));
+
+  // Slot-wise (a + b) * 3
+  std::vector<BigNumber> v1(exp_value1.begin(), exp_value1.end());
+  std::vector<BigNumber> v2(exp_value2.begin(), exp_value2.end());
+  ipcl::PackedCipherText ct1(key.pub_key, packer, v1);
+  ipcl::PackedCipherText ct2(key.pub_key, packer, v2);
+  ipcl::PackedCipherText res = (ct1 + ct2) * BigNumber(3u);
+  EXPECT_EQ(res.getHeadroom(), 5);
+
+  dt = res.decrypt(key.priv_key);
+  for (uint32_t i = 0; i < num_values; i++)
+    EXPECT_EQ(dt[i], (v1[i] + v2[i]) * BigNumber(3u));
+
+  // Headroom is tracked, a carry into the next slot is refused
+  EXPECT_THROW(res * BigNumber(64u), std::runtime_error);
+  BigNumber too_wide = BigNumber(0x10000u) * BigNumber(0x10000u);
+  EXPECT_THROW(packer.pack(std::vector<BigNumber>{too_wide}),
+               std::runtime_error);
+}
+
+TEST(CryptoTest, CompactTest) {
+  const uint32_t num_values = 50;
+  ipcl::KeyPair key = ipcl::generateKeypair(1024, true);
+  ipcl::SlotPacker packer(key.pub_key, 24, 4);
+
+  std::vector<uint32_t> exp_value(num_values);
+  std::random_device dev;
+  std::mt19937 rng(dev());
+  std::uniform_int_distribution<std::mt19937::result_type> dist(0, 0xffffff);
+  for (uint32_t i = 0; i < num_values; i++) exp_value[i] = dist(rng);
+
+  // Aggregated CipherText of 25-bit sums, compacted into 3 elements
+  ipcl::PlainText pt(exp_value);
+  ipcl::CipherText ct = key.pub_key.encrypt(pt);
+  ct = ct + ct;
+  ipcl::PackedCipherText packed =
+      ipcl::PackedCipherText::compact(packer, ct, BigNumber(0x2000000u));
+  EXPECT_EQ(packed.getCipherText().getSize(),
+            packer.getPackedSize(num_values));
+  EXPECT_EQ(packed.getHeadroom(), 2);
+
+  std::vector<BigNumber> dt = (packed + packed).decrypt(key.priv_key);
+  for (uint32_t i = 0; i < num_values; i++)
+    EXPECT_EQ(dt[i], BigNumber(exp_value[i] * 4));
+}
@@ -606,3 +606,605 @@ TEST(OperationTest, PtMultiplyCtArrayTest) {
     EXPECT_EQ(product, exp_product);
   }
 }
+
+TEST(OperationTest, CtSumTest) {
+  // Long enough to use several blocks and the 8-lane kernels
+  const uint32_t num_values = 131;
+
+  ipcl::KeyPair key = ipcl::generateKeypair(2048);
+
+  std::vector<uint32_t> exp_value(num_values);
+  ipcl::PlainText pt, dt_sum;
+  ipcl::CipherText ct, ct_sum;
+
+  std::random_device dev;
+  std::mt19937 rng(dev());
+  std::uniform_int_distribution<std::mt19937::result_type> dist(0, UINT_MAX);
+
+  uint64_t exp_sum = 0;
+  for (int i = 0; i < num_values; i++) {
+    exp_value[i] = dist(rng);
+    exp_sum += exp_value[i];
+  }
+  pt = ipcl::PlainText(exp_value);
+
+  ct = key.pub_key.encrypt(pt);
+  ct_sum = ct.sum();
+  EXPECT_EQ(ct_sum.getSize(), 1);
+
+  dt_sum = key.priv_key.decrypt(ct_sum);
+
+  std::vector<uint32_t> v = dt_sum.getElementVec(0);
+  uint64_t sum = v[0];
+  if (v.size() > 1) sum = ((uint64_t)v[1] << 32) | v[0];
+
+  EXPECT_EQ(sum, exp_sum);
+}
+
+TEST(OperationTest, CtSumArrayTest) {
+  ipcl::KeyPair key = ipcl::generateKeypair(2048);
+
+  std::random_device dev;
+  std::mt19937 rng(dev());
+  std::uniform_int_distribution<std::mt19937::result_type> dist(0, UINT_MAX);
+
+  // Wide rows and long columns take different reduction paths
+  for (uint32_t num_values : {SELF_DEF_NUM_VALUES, 2}) {
+    const int num_cts = 5;
+    std::vector<ipcl::CipherText> cts(num_cts);
+    std::vector<uint64_t> exp_sum(num_values, 0);
+
+    for (int k = 0; k < num_cts; k++) {
+      std::vector<uint32_t> exp_value(num_values);
+      for (int i = 0; i < num_values; i++) {
+        exp_value[i] = dist(rng);
+        exp_sum[i] += exp_value[i];
+      }
+      cts[k] = key.pub_key.encrypt(ipcl::PlainText(exp_value));
+    }
+
+    ipcl::CipherText ct_sum = ipcl::CipherText::sum(cts);
+    ipcl::PlainText dt_sum = key.priv_key.decrypt(ct_sum);
+
+    for (int i = 0; i < num_values; i++) {
+      std::vector<uint32_t> v = dt_sum.getElementVec(i);
+      uint64_t sum = v[0];
+      if (v.size() > 1) sum = ((uint64_t)v[1] << 32) | v[0];
+
+      EXPECT_EQ(sum, exp_sum[i]);
+    }
+  }
+}
+
+TEST(OperationTest, CtDotPtTest) {
+  ipcl::KeyPair key = ipcl::generateKeypair(2048);
+
+  std::random_device dev;
+  std::mt19937 rng(dev());
+  std::uniform_int_distribution<std::mt19937::result_type> dist(0, UINT_MAX);
+
+  // Short and long inputs use different multi-exponentiation methods
+  for (uint32_t num_values : {SELF_DEF_NUM_VALUES, 100}) {
+    std::vector<uint32_t> exp_value1(num_values), exp_value2(num_values);
+    BigNumber exp_dot = BigNumber::Zero();
+    for (int i = 0; i < num_values; i++) {
+      exp_value1[i] = dist(rng);
+      exp_value2[i] = dist(rng);
+      exp_dot += BigNumber(exp_value1[i]) * BigNumber(exp_value2[i]);
+    }
+    ipcl::PlainText pt1(exp_value1);
+    ipcl::PlainText pt2(exp_value2);
+
+    ipcl::CipherText ct1 = key.pub_key.encrypt(pt1);
+    ipcl::CipherText ct_dot = ct1.dot(pt2);
+    EXPECT_EQ(ct_dot.getSize(), 1);
+
+    ipcl::PlainText dt_dot = key.priv_key.decrypt(ct_dot);
+    EXPECT_EQ(dt_dot.getElement(0), exp_dot);
+
+    // Negative weights given as -m or as n - m
+    const BigNumber& n = *(key.pub_key.getN());
+    std::vector<BigNumber> signed_w(num_values);
+    BigNumber exp_signed = BigNumber::Zero();
+    for (int i = 0; i < num_values; i++) {
+      BigNumber w(exp_value2[i]);
+      signed_w[i] = w;
+      if (i % 3 == 1) signed_w[i] = BigNumber::Zero() - w;
+      if (i % 3 == 2) signed_w[i] = n - w;
+      exp_signed += BigNumber(exp_value1[i]) * (i % 3 ? n - w : w);
+    }
+    ipcl::PlainText dt_signed =
+        key.priv_key.decrypt(ct1.dot(ipcl::PlainText(signed_w)));
+    EXPECT_EQ(dt_signed.getElement(0), exp_signed % n);
+  }
+}
+
+TEST(OperationTest, CtMatVecTest) {
+  const uint32_t num_values = SELF_DEF_NUM_VALUES;
+  const std::size_t num_rows = 20;
+
+  ipcl::KeyPair key = ipcl::generateKeypair(2048);
+
+  std::random_device dev;
+  std::mt19937 rng(dev());
+  std::uniform_int_distribution<std::mt19937::result_type> dist(0, UINT_MAX);
+
+  std::vector<uint32_t> exp_value(num_values);
+  for (int i = 0; i < num_values; i++) exp_value[i] = dist(rng);
+  ipcl::CipherText ct = key.pub_key.encrypt(ipcl::PlainText(exp_value));
+
+  // Dense matrix and a CSR copy holding every other entry
+  ipcl::DenseMatrix dense;
+  ipcl::CSRMatrix csr;
+  dense.rows = csr.rows = num_rows;
+  dense.cols = csr.cols = num_values;
+  csr.row_ptr.push_back(0);
+  std::vector<BigNumber> exp_dense(num_rows, BigNumber::Zero());
+  std::vector<BigNumber> exp_csr(num_rows, BigNumber::Zero());
+  for (std::size_t r = 0; r < num_rows; r++) {
+    for (int j = 0; j < num_values; j++) {
+      BigNumber w = BigNumber(static_cast<Ipp32u>(dist(rng)));
+      dense.values.push_back(w);
+      exp_dense[r] += w * BigNumber(exp_value[j]);
+      if ((r + j) % 2) {
+        csr.col_idx.push_back(j);
+        csr.values.push_back(w);
+        exp_csr[r] += w * BigNumber(exp_value[j]);
+      }
+    }
+    csr.row_ptr.push_back(csr.values.size());
+  }
+
+  ipcl::PlainText dt_dense = key.priv_key.decrypt(ct.matVec(dense));
+  ipcl::PlainText dt_csr = key.priv_key.decrypt(ct.matVec(csr));
+
+  for (std::size_t r = 0; r < num_rows; r++) {
+    EXPECT_EQ(dt_dense.getElement(r), exp_dense[r]);
+    EXPECT_EQ(dt_csr.getElement(r), exp_csr[r]);
+  }
+
+  // Negative entries given as -m or as n - m, the first row is all negative
+  // and the second row has none
+  const BigNumber& n = *(key.pub_key.getN());
+  auto to_signed = [&](std::vector<BigNumber>& values,
+                       const std::vector<std::size_t>& rows,
+                       std::vector<BigNumber>& expected,
+                       const std::vector<std::size_t>& cols) {
+    expected.assign(expected.size(), BigNumber::Zero());
+    for (std::size_t k = 0; k < values.size(); k++) {
+      BigNumber w = values[k];
+      bool neg = rows[k] == 0 || (rows[k] != 1 && k % 3);
+      if (neg) values[k] = k % 2 ? BigNumber::Zero() - w : n - w;
+      expected[rows[k]] += BigNumber(exp_value[cols[k]]) * (neg ? n - w : w);
+    }
+    for (BigNumber& e : expected) e = e % n;
+  };
+  std::vector<std::size_t> dense_rows, dense_cols, csr_rows;
+  for (std::size_t k = 0; k < dense.values.size(); k++) {
+    dense_rows.push_back(k / num_values);
+    dense_cols.push_back(k % num_values);
+  }
+  for (std::size_t r = 0; r < num_rows; r++)
+    for (std::size_t k = csr.row_ptr[r]; k < csr.row_ptr[r + 1]; k++)
+      csr_rows.push_back(r);
+  to_signed(dense.values, dense_rows, exp_dense, dense_cols);
+  to_signed(csr.values, csr_rows, exp_csr, csr.col_idx);
+
+  dt_dense = key.priv_key.decrypt(ct.matVec(dense));
+  dt_csr = key.priv_key.decrypt(ct.matVec(csr));
+
+  for (std::size_t r = 0; r < num_rows; r++) {
+    EXPECT_EQ(dt_dense.getElement(r), exp_dense[r]);
+    EXPECT_EQ(dt_csr.getElement(r), exp_csr[r]);
+  }
+}
+
+TEST(OperationTest, CtMultiplyPtPrecomputeTest) {
+  const uint32_t num_values = SELF_DEF_NUM_VALUES;
+
+  ipcl::KeyPair key = ipcl::generateKeypair(2048);
+
+  std::random_device dev;
+  std::mt19937 rng(dev());
+  std::uniform_int_distribution<std::mt19937::result_type> dist(0, UINT_MAX);
+
+  std::vector<uint32_t> exp_value1(num_values), exp_value2(num_values);
+  for (int i = 0; i < num_values; i++) {
+    exp_value1[i] = dist(rng);
+    exp_value2[i] = dist(rng);
+  }
+  ipcl::PlainText pt1(exp_value1);
+  ipcl::PlainText pt2(exp_value2);
+
+  ipcl::CipherText ct1 = key.pub_key.encrypt(pt1);
+  ipcl::CipherText ct_ref = ct1 * pt2;
+
+  // Small window and exponent size to exercise the fallback as well
+  ipcl::CipherText ct_pre = ct1;
+  ct_pre.precompute(4, 32);
+  EXPECT_GT(ct_pre.getFixedBaseCache()->getBytes(), 0);
+
+  ipcl::CipherText ct_res = ct_pre * pt2;
+  for (int i = 0; i < num_values; i++)
+    EXPECT_EQ(ct_res.getElement(i), ct_ref.getElement(i));
+
+  BigNumber big = *(key.pub_key.getN()) - 1;
+  ipcl::CipherText ct_big = ct_pre * ipcl::PlainText(big);
+  ipcl::CipherText ct_big_ref = ct1 * ipcl::PlainText(big);
+  for (int i = 0; i < num_values; i++)
+    EXPECT_EQ(ct_big.getElement(i), ct_big_ref.getElement(i));
+
+  // Single CipherText broadcast over many plaintexts
+  ipcl::CipherText ct_one = ct1.getCipherText(0);
+  ct_one.precompute();
+  ipcl::CipherText ct_fan = ct_one * pt2;
+  EXPECT_EQ(ct_fan.getSize(), num_values);
+
+  ipcl::PlainText dt_fan = key.priv_key.decrypt(ct_fan);
+  for (int i = 0; i < num_values; i++)
+    EXPECT_EQ(dt_fan.getElement(i),
+              BigNumber(exp_value1[0]) * BigNumber(exp_value2[i]));
+}
+
+TEST(OperationTest, FixedBaseCacheTest) {
+  ipcl::KeyPair key = ipcl::generateKeypair(1024);
+  std::shared_ptr<const ipcl::ModMulEngine> engine =
+      key.pub_key.getNSQMulEngine();
+
+  const BigNumber& sq = *(key.pub_key.getNSQ());
+  BigNumber g1 = key.pub_key.encrypt(ipcl::PlainText(123u)).getElement(0);
+  BigNumber g2 = g1 * g1 % sq;
+  auto t1 = std::make_shared<ipcl::FixedBaseTable>(g1, 64, 4, engine);
+  auto t2 = std::make_shared<ipcl::FixedBaseTable>(g2, 64, 4, engine);
+
+  BigNumber e("0x123456789abcdef0");
+  EXPECT_EQ(t1->pow(e), ipcl::modExp(g1, e, sq));
+
+  // Room for a single table, the least recently used one is evicted
+  ipcl::FixedBaseCache cache(t1->getBytes() + t1->getBytes() / 2);
+  cache.insert(0, t1);
+  EXPECT_EQ(cache.find(0, g1, 64), t1);
+  EXPECT_EQ(cache.find(0, g1, 65), nullptr);
+  EXPECT_EQ(cache.find(0, g2, 64), nullptr);
+
+  cache.insert(1, t2);
+  EXPECT_EQ(cache.find(0, g1, 64), nullptr);
+  EXPECT_EQ(cache.find(1, g2, 32), t2);
+  EXPECT_EQ(cache.getBytes(), t2->getBytes());
+}
+
+TEST(OperationTest, CtLazyExprTest) {
+  const uint32_t num_values = SELF_DEF_NUM_VALUES;
+
+  ipcl::KeyPair key = ipcl::generateKeypair(2048);
+
+  std::random_device dev;
+  std::mt19937 rng(dev());
+  std::uniform_int_distribution<std::mt19937::result_type> dist(0, UINT_MAX);
+
+  auto random_pt = [&]() {
+    std::vector<uint32_t> v(num_values);
+    for (int i = 0; i < num_values; i++) v[i] = dist(rng);
+    return ipcl::PlainText(v);
+  };
+  auto expect_same = [&](const ipcl::CipherText& a, const ipcl::CipherText& b) {
+    ASSERT_EQ(a.getSize(), b.getSize());
+    for (int i = 0; i < a.getSize(); i++)
+      EXPECT_EQ(a.getElement(i), b.getElement(i));
+  };
+
+  ipcl::PlainText x = random_pt(), y = random_pt(), p = random_pt();
+  ipcl::CipherText a = key.pub_key.encrypt(random_pt());
+  ipcl::CipherText b = key.pub_key.encrypt(random_pt());
+  ipcl::CipherText c = key.pub_key.encrypt(random_pt());
+
+  // Few CipherTexts, batched exponentiations
+  ipcl::CipherText ct_lazy = (a.lazy() * x + b.lazy() * y + c + p).eval();
+  expect_same(ct_lazy, a * x + b * y + c + p);
+
+  // Negative weights given as -m or as n - m
+  const BigNumber& n = *(key.pub_key.getN());
+  auto signed_pt = [&]() {
+    std::vector<BigNumber> v(num_values);
+    for (int i = 0; i < num_values; i++) {
+      v[i] = BigNumber(static_cast<Ipp32u>(dist(rng)));
+      if (i % 3 == 1) v[i] = BigNumber::Zero() - v[i];
+      if (i % 3 == 2) v[i] = n - v[i];
+    }
+    return ipcl::PlainText(v);
+  };
+  ipcl::PlainText s = signed_pt();
+  expect_same((a.lazy() * s + b.lazy() * y + p).eval(), a * s + b * y + p);
+
+  // Separate lazy() calls on the same CipherText
+  expect_same((a.lazy() * x + a.lazy() * s + a).eval(), a * x + a * s + a);
+
+  // Shared sub-expressions and broadcast scalars
+  ipcl::PlainText k(5u);
+  ipcl::CipherExpr e = a.lazy() * x + p;
+  expect_same((e + e * k + a).eval(), (a * x + p) + (a * x + p) * k + a);
+
+  ipcl::PlainText dt = key.priv_key.decrypt((k * (x + a.lazy())).eval());
+  ipcl::PlainText dt_ref = key.priv_key.decrypt((a + x) * k);
+  for (int i = 0; i < num_values; i++)
+    EXPECT_EQ(dt.getElement(i), dt_ref.getElement(i));
+
+  // Many CipherTexts, one multi-exponentiation per element
+  ipcl::CipherExpr sum = a.lazy() * x;
+  ipcl::CipherText sum_ref = a * x;
+  for (int j = 0; j < ipcl::IPCL_EXPR_MULTI_EXP_TERMS; j++) {
+    ipcl::CipherText ct = key.pub_key.encrypt(random_pt());
+    ipcl::PlainText w = (j % 2) ? signed_pt() : random_pt();
+    sum = sum + ct.lazy() * w;
+    sum_ref = sum_ref + ct * w;
+  }
+  expect_same(sum.eval(), sum_ref);
+}
+
+TEST(OperationTest, CtMontgomeryTest) {
+  const uint32_t num_values = SELF_DEF_NUM_VALUES;
+
+  ipcl::KeyPair key = ipcl::generateKeypair(2048);
+
+  std::random_device dev;
+  std::mt19937 rng(dev());
+  std::uniform_int_distribution<std::mt19937::result_type> dist(0, UINT_MAX);
+
+  auto random_pt = [&]() {
+    std::vector<uint32_t> v(num_values);
+    for (int i = 0; i < num_values; i++) v[i] = dist(rng);
+    return ipcl::PlainText(v);
+  };
+
+  ipcl::PlainText x = random_pt(), y = random_pt();
+  ipcl::CipherText a = key.pub_key.encrypt(random_pt());
+  ipcl::CipherText b = key.pub_key.encrypt(random_pt());
+
+  ipcl::CipherText a_mont = a.toMontgomery();
+  EXPECT_TRUE(a_mont.isMontgomery());
+  EXPECT_FALSE(a_mont.fromMontgomery().isMontgomery());
+
+  // Chain of additions and scalar multiplications, compared with normal mode
+  ipcl::CipherText ct_ref = ((a + b) * x + b + y + a.getCipherText(0)) * y;
+  ipcl::CipherText ct_mont =
+      ((a_mont + b) * x + b.toMontgomery() + y + a_mont.getCipherText(0)) * y;
+  EXPECT_TRUE(ct_mont.isMontgomery());
+
+  std::vector<BigNumber> ref = ct_ref.getTexts();
+  std::vector<BigNumber> res = ct_mont.getTexts();
+  std::vector<BigNumber> res_normal = ct_mont.fromMontgomery().getTexts();
+  for (int i = 0; i < num_values; i++) {
+    EXPECT_EQ(res[i], ref[i]);
+    EXPECT_EQ(res_normal[i], ref[i]);
+    EXPECT_EQ(ct_mont.getElement(i), ref[i]);
+    EXPECT_EQ(ct_mont.getElementHex(i), ct_ref.getElementHex(i));
+  }
+
+  // BaseText accessors see the normal form as well
+  const ipcl::BaseText& base_mont = ct_mont;
+  EXPECT_EQ(base_mont.getElement(1), ref[1]);
+  EXPECT_EQ(base_mont.getTexts(), ref);
+  EXPECT_ANY_THROW(ct_mont[0]);
+  ipcl::CipherText ins_mont = ct_mont, ins_ref = ct_ref;
+  BigNumber elem = ref[2];
+  ins_mont.insert(1, elem);
+  ins_ref.insert(1, elem);
+  EXPECT_TRUE(ins_mont.isMontgomery());
+  EXPECT_EQ(ins_mont.getTexts(), ins_ref.getTexts());
+
+  ipcl::CipherText rot_mont = ct_mont.rotate(3);
+  EXPECT_TRUE(rot_mont.isMontgomery());
+  EXPECT_EQ(rot_mont.getTexts(), ct_ref.rotate(3).getTexts());
+  EXPECT_EQ(ct_mont.sum().getElement(0), ct_ref.sum().getElement(0));
+
+  // Exponentiations and products stay in the Montgomery domain
+  auto expect_mont = [](const ipcl::CipherText& res,
+                        const ipcl::CipherText& ref) {
+    EXPECT_TRUE(res.isMontgomery());
+    EXPECT_EQ(res.getTexts(), ref.getTexts());
+  };
+  std::vector<BigNumber> w(num_values);
+  for (int i = 0; i < num_values; i++) {
+    w[i] = BigNumber(static_cast<Ipp32u>(dist(rng)));
+    if (i % 2) w[i] = BigNumber::Zero() - w[i];
+  }
+  ipcl::PlainText pw(w), pw_neg(w[1]);
+  expect_mont(a_mont * pw, a * pw);
+  expect_mont(a_mont * pw_neg, a * pw_neg);
+  expect_mont(a_mont.getCipherText(0) * pw, a.getCipherText(0) * pw);
+  expect_mont(-a_mont, -a);
+  expect_mont(a_mont.sum(), a.sum());
+  expect_mont(ipcl::CipherText::sum({a_mont, b, a_mont}),
+              ipcl::CipherText::sum({a, b, a}));
+  expect_mont(ipcl::CipherText::sum({a_mont.getCipherText(0),
+                                     b.getCipherText(0), a.getCipherText(1),
+                                     b.getCipherText(1).toMontgomery()}),
+              ipcl::CipherText::sum({a.getCipherText(0), b.getCipherText(0),
+                                     a.getCipherText(1), b.getCipherText(1)}));
+  expect_mont(a_mont.dot(x), a.dot(x));
+
+  ipcl::DenseMatrix dense;
+  dense.rows = 3;
+  dense.cols = num_values;
+  for (std::size_t k = 0; k < dense.rows * dense.cols; k++)
+    dense.values.push_back(BigNumber(static_cast<Ipp32u>(dist(rng))));
+  expect_mont(a_mont.matVec(dense), a.matVec(dense));
+
+  // Negative weights take the inversion path
+  expect_mont(a_mont.dot(pw), a.dot(pw));
+  dense.values[1] = BigNumber::Zero() - dense.values[1];
+  expect_mont(a_mont.matVec(dense), a.matVec(dense));
+
+  ipcl::PlainText dt_mont = key.priv_key.decrypt(ct_mont);
+  ipcl::PlainText dt_ref = key.priv_key.decrypt(ct_ref);
+  for (int i = 0; i < num_values; i++)
+    EXPECT_EQ(dt_mont.getElement(i), dt_ref.getElement(i));
+}
+
+TEST(OperationTest, CtAccumulatorTest) {
+  const uint32_t num_values = SELF_DEF_NUM_VALUES;
+  const std::size_t num_cts = 40;
+  const std::size_t num_parts = 4;
+
+  ipcl::KeyPair key = ipcl::generateKeypair(2048);
+
+  std::random_device dev;
+  std::mt19937 rng(dev());
+  std::uniform_int_distribution<std::mt19937::result_type> dist(0, UINT_MAX);
+
+  std::vector<ipcl::CipherText> cts(num_cts);
+  for (std::size_t k = 0; k < num_cts; k++) {
+    std::vector<uint32_t> v(num_values);
+    for (int i = 0; i < num_values; i++) v[i] = dist(rng);
+    cts[k] = key.pub_key.encrypt(ipcl::PlainText(v));
+    if (k % 3 == 0) cts[k] = cts[k].toMontgomery();
+  }
+  ipcl::CipherText single = cts[1].getCipherText(0);
+  std::vector<BigNumber> ref =
+      (ipcl::CipherText::sum(cts) + single).getTexts();
+
+  ipcl::CipherAccumulator acc(key.pub_key, num_values);
+  for (const auto& ct : cts) acc += ct;
+  acc.add(single);
+  EXPECT_EQ(acc.getCount(), num_cts + 1);
+  EXPECT_EQ(acc.getCipherText().getTexts(), ref);
+
+  // One accumulator per producer, merged at the end
+  std::vector<ipcl::CipherAccumulator> parts(
+      num_parts, ipcl::CipherAccumulator(key.pub_key, num_values));
+#pragma omp parallel for
+  for (int p = 0; p < num_parts; p++)
+    for (std::size_t k = p; k < num_cts; k += num_parts) parts[p].add(cts[k]);
+
+  ipcl::CipherAccumulator merged(key.pub_key, num_values);
+  merged.add(single);
+  for (const auto& part : parts) merged.merge(part);
+  EXPECT_EQ(merged.getCount(), num_cts + 1);
+  EXPECT_EQ(merged.getCipherText().getTexts(), ref);
+
+  ipcl::PlainText dt = key.priv_key.decrypt(merged.getCipherText());
+  ipcl::PlainText dt_ref = key.priv_key.decrypt(ipcl::CipherText::sum(cts));
+  for (int i = 0; i < num_values; i++)
+    EXPECT_EQ(dt.getElement(i),
+              (dt_ref.getElement(i) +
+               key.priv_key.decrypt(single).getElement(0)) %
+                  *(key.pub_key.getN()));
+}
+
+TEST(OperationTest, CtMultiplyNegativePtTest) {
+  const uint32_t num_values = SELF_DEF_NUM_VALUES;
+
+  ipcl::KeyPair key = ipcl::generateKeypair(2048);
+  const BigNumber& n = *(key.pub_key.getN());
+
+  std::random_device dev;
+  std::mt19937 rng(dev());
+  std::uniform_int_distribution<std::mt19937::result_type> dist(0, UINT_MAX);
+
+  // Every other weight negative, encoded as n - |w| and given as -|w|
+  std::vector<uint32_t> exp_value1(num_values);
+  std::vector<BigNumber> encoded(num_values), signed_w(num_values),
+      expected(num_values);
+  for (int i = 0; i < num_values; i++) {
+    exp_value1[i] = dist(rng);
+    BigNumber w(static_cast<uint32_t>(dist(rng)));
+    bool neg = i % 2;
+    encoded[i] = neg ? n - w : w;
+    signed_w[i] = neg ? BigNumber::Zero() - w : w;
+    expected[i] = (BigNumber(exp_value1[i]) * encoded[i]) % n;
+  }
+
+  ipcl::CipherText ct = key.pub_key.encrypt(ipcl::PlainText(exp_value1));
+  ipcl::CipherText ct_enc = ct * ipcl::PlainText(encoded);
+  ipcl::CipherText ct_sgn = ct * ipcl::PlainText(signed_w);
+  EXPECT_EQ(ct_enc.getTexts(), ct_sgn.getTexts());
+
+  ipcl::PlainText dt = key.priv_key.decrypt(ct_enc);
+  for (int i = 0; i < num_values; i++)
+    EXPECT_EQ(dt.getElement(i), expected[i]);
+
+  // Broadcast negative scalar and precomputed tables
+  BigNumber minus_one = n - 1;
+  ipcl::CipherText ct_pre = ct;
+  ct_pre.precompute(4, 32);
+  ipcl::PlainText dt_neg =
+      key.priv_key.decrypt(ct_pre * ipcl::PlainText(minus_one));
+  for (int i = 0; i < num_values; i++)
+    EXPECT_EQ(dt_neg.getElement(i), n - BigNumber(exp_value1[i]));
+}
+
+TEST(OperationTest, CtMinusCtTest) {
+  const uint32_t num_values = SELF_DEF_NUM_VALUES;
+
+  ipcl::KeyPair key = ipcl::generateKeypair(2048);
+  const BigNumber& n = *(key.pub_key.getN());
+
+  std::random_device dev;
+  std::mt19937 rng(dev());
+  std::uniform_int_distribution<std::mt19937::result_type> dist(0, UINT_MAX);
+
+  std::vector<uint32_t> exp_value1(num_values), exp_value2(num_values);
+  for (int i = 0; i < num_values; i++) {
+    exp_value1[i] = dist(rng);
+    exp_value2[i] = dist(rng);
+  }
+  ipcl::PlainText pt1(exp_value1);
+  ipcl::PlainText pt2(exp_value2);
+
+  ipcl::CipherText ct1 = key.pub_key.encrypt(pt1);
+  ipcl::CipherText ct2 = key.pub_key.encrypt(pt2);
+
+  auto diff = [&](const BigNumber& a, const BigNumber& b) {
+    return (a + n - b) % n;
+  };
+
+  ipcl::PlainText dt_ctct = key.priv_key.decrypt(ct1 - ct2);
+  ipcl::PlainText dt_ctpt = key.priv_key.decrypt(ct1 - pt2);
+  ipcl::PlainText dt_neg = key.priv_key.decrypt(-ct2);
+  ipcl::PlainText dt_mont =
+      key.priv_key.decrypt(ct1.toMontgomery() - ct2.toMontgomery());
+  ipcl::PlainText dt_bcast = key.priv_key.decrypt(ct1 - ct2.getCipherText(0));
+  for (int i = 0; i < num_values; i++) {
+    BigNumber m1(exp_value1[i]), m2(exp_value2[i]);
+    EXPECT_EQ(dt_ctct.getElement(i), diff(m1, m2));
+    EXPECT_EQ(dt_ctpt.getElement(i), diff(m1, m2));
+    EXPECT_EQ(dt_neg.getElement(i), diff(BigNumber::Zero(), m2));
+    EXPECT_EQ(dt_mont.getElement(i), diff(m1, m2));
+    EXPECT_EQ(dt_bcast.getElement(i), diff(m1, BigNumber(exp_value2[0])));
+  }
+}
+
+TEST(OperationTest, CtPlusPtFusedTest) {
+  const uint32_t num_values = SELF_DEF_NUM_VALUES;
+
+  ipcl::KeyPair key = ipcl::generateKeypair(2048);
+  const BigNumber& n = *(key.pub_key.getN());
+
+  std::random_device dev;
+  std::mt19937 rng(dev());
+  std::uniform_int_distribution<std::mt19937::result_type> dist(0, UINT_MAX);
+
+  // Plaintexts up to and beyond n
+  std::vector<uint32_t> exp_value1(num_values);
+  std::vector<BigNumber> exp_value2(num_values);
+  for (int i = 0; i < num_values; i++) {
+    exp_value1[i] = dist(rng);
+    exp_value2[i] = BigNumber(static_cast<uint32_t>(dist(rng)));
+  }
+  exp_value2[0] = n - 1;
+  exp_value2[1] = n + 5;
+  exp_value2[2] = BigNumber::Zero();
+  ipcl::PlainText pt2(exp_value2);
+
+  ipcl::CipherText ct1 = key.pub_key.encrypt(ipcl::PlainText(exp_value1));
+  ipcl::CipherText ref = ct1 + key.pub_key.encrypt(pt2, false);
+
+  EXPECT_EQ((ct1 + pt2).getTexts(), ref.getTexts());
+  ipcl::CipherText ct_mont = ct1.toMontgomery() + pt2;
+  EXPECT_TRUE(ct_mont.isMontgomery());
+  EXPECT_EQ(ct_mont.getTexts(), ref.getTexts());
+
+  ipcl::PlainText dt = key.priv_key.decrypt(ct1 + ipcl::PlainText(n - 1));
+  for (int i = 0; i < num_values; i++)
+    EXPECT_EQ(dt.getElement(i), (BigNumber(exp_value1[i]) + n - 1) % n);
+}